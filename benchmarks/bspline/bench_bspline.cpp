@@ -1,6 +1,9 @@
 // Standard includes
+#include <algorithm>
 #include <cmath>
+#include <random>
 #include <string>
+#include <utility>
 
 // Third-party includes
 #include <catch2/benchmark/catch_benchmark_all.hpp>
@@ -8,6 +11,14 @@
 
 // BSplineX includes
 #include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/bspline/bspline_circulant.hpp"
+#include "BSplineX/bspline/bspline_cursor.hpp"
+#include "BSplineX/bspline/bspline_fitter.hpp"
+#include "BSplineX/bspline/bspline_prepared_fit.hpp"
+#include "BSplineX/bspline/bspline_smoothing.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+#include "BSplineX/bspline/bspline_window.hpp"
+#include "BSplineX/ppoly/ppoly.hpp"
 
 using namespace bsplinex;
 using namespace bsplinex::bspline;
@@ -89,6 +100,31 @@ TEST_CASE(
         return res;
       };
 
+      y_data.resize(x_data.size());
+      BENCHMARK(
+          "bspline.evaluate_batch - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
+
+      ppoly::PPoly ppoly{bspline};
+      BENCHMARK(
+          "ppoly.evaluate_batch - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        ppoly.evaluate(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
+
+      BENCHMARK("ppoly.convert - knots: " + std::to_string(knots_num))
+      {
+        return ppoly::PPoly{bspline};
+      };
+
       y_data.clear();
       y_data.reserve(x_data.size());
       for (auto x : x_data)
@@ -153,6 +189,7 @@ TEST_CASE(
   std::vector<double> knots{};
   std::vector<double> ctrl_pts{};
   std::vector<double> x_data{};
+  std::vector<double> y_data{};
   double res{0.0};
   double eval_elems{0.0};
   double start{45.0};
@@ -182,6 +219,790 @@ TEST_CASE(
         }
         return res;
       };
+
+      y_data.resize(x_data.size());
+      BENCHMARK(
+          "bspline.evaluate_batch - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
+
+      BENCHMARK(
+          "bspline.evaluate_ordered - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        bspline.evaluate_ordered(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
+
+      BENCHMARK(
+          "bspline.cursor - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        Cursor cursor{bspline};
+        for (auto x : x_data)
+        {
+          res = cursor.evaluate(x);
+        }
+        return res;
+      };
+
+      ppoly::PPoly ppoly{bspline};
+      BENCHMARK(
+          "ppoly.evaluate_batch - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        ppoly.evaluate(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
+
+      BENCHMARK(
+          "bspline.basis dense - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        for (auto x : x_data)
+        {
+          res = bspline.basis(x).back();
+        }
+        return res;
+      };
+
+      std::vector<size_t> indices(x_data.size());
+      std::vector<double> nnz(x_data.size() * (degree + 1));
+      BENCHMARK(
+          "bspline.basis sparse batch - knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string((size_t)eval_elems)
+      )
+      {
+        bspline.basis(x_data.data(), x_data.size(), indices.data(), nnz.data());
+        return nnz.back();
+      };
+    }
+  }
+}
+
+TEST_CASE(
+    "benchmark knot search policies for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::OPEN, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t eval_elems{10000};
+  std::vector<std::pair<Search, std::string>> searches{
+      {Search::BINARY, "binary"},
+      {Search::BRANCHLESS, "branchless"},
+      {Search::EYTZINGER, "eytzinger"},
+      {Search::LINEAR, "linear"},
+      {Search::BUCKET, "bucket"},
+      {Search::AUTO, "auto"}
+  };
+
+  std::mt19937 rng{42};
+  std::vector<double> knots{};
+  std::vector<double> ctrl_pts{};
+  std::vector<double> x_data(eval_elems);
+  std::vector<double> y_data(eval_elems);
+  for (size_t j{4}; j < 19; j += 2)
+  {
+    size_t knots_num = (size_t)1 << j;
+
+    // Mildly irregular knots, queried at random over the whole domain
+    knots.resize(knots_num);
+    std::uniform_real_distribution<double> step{0.5, 1.5};
+    knots.at(0) = 0.0;
+    for (size_t i{1}; i < knots_num; i++)
+    {
+      knots.at(i) = knots.at(i - 1) + step(rng);
+    }
+    ctrl_pts.assign(knots_num - degree - 1, 1.0);
+    std::uniform_real_distribution<double> unif{knots.at(degree), knots.at(knots_num - degree - 1)};
+    std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+
+    BSpline<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> bspline{
+        {knots}, {ctrl_pts}, degree
+    };
+
+    for (auto const &[search, name] : searches)
+    {
+      // Linear search on huge knot vectors only shows the obvious
+      if (search == Search::LINEAR && knots_num > 4096)
+      {
+        continue;
+      }
+
+      bspline.set_search(search);
+      BENCHMARK(
+          "bspline.evaluate_batch - search: " + name + " knots: " + std::to_string(knots_num) +
+          " evals: " + std::to_string(eval_elems)
+      )
+      {
+        bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+        return y_data.back();
+      };
     }
   }
 }
+
+TEST_CASE(
+    "benchmark bucket index sizes for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::OPEN, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{(size_t)1 << 14};
+  size_t eval_elems{10000};
+
+  // Knots clustered towards the left end, so that coarse buckets hold many knots
+  std::vector<double> knots(knots_num);
+  for (size_t i{0}; i < knots_num; i++)
+  {
+    double x{(double)i / (double)(knots_num - 1)};
+    knots.at(i) = x * x * x;
+  }
+  std::vector<double> ctrl_pts(knots_num - degree - 1, 1.0);
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{knots.at(degree), knots.at(knots_num - degree - 1)};
+  std::vector<double> x_data(eval_elems);
+  std::vector<double> y_data(eval_elems);
+  std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+
+  BSpline<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> bspline{
+      {knots}, {ctrl_pts}, degree
+  };
+
+  for (size_t num_buckets{knots_num / 64}; num_buckets <= knots_num * 16; num_buckets *= 4)
+  {
+    bspline.set_search(Search::BUCKET, num_buckets);
+    BENCHMARK(
+        "bspline.evaluate_batch - buckets: " + std::to_string(num_buckets) +
+        " memory: " + std::to_string(bspline.search_memory()) +
+        " B knots: " + std::to_string(knots_num) + " evals: " + std::to_string(eval_elems)
+    )
+    {
+      bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+      return y_data.back();
+    };
+  }
+
+  bspline.set_search(Search::BRANCHLESS);
+  BENCHMARK(
+      "bspline.evaluate_batch - search: branchless knots: " + std::to_string(knots_num) +
+      " evals: " + std::to_string(eval_elems)
+  )
+  {
+    bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+    return y_data.back();
+  };
+}
+
+TEST_CASE(
+    "benchmark parallel evaluation for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::OPEN, Extrapolation::CONSTANT>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{1024};
+  size_t eval_elems{(size_t)1 << 22};
+
+  std::mt19937 rng{42};
+  std::vector<double> knots(knots_num);
+  std::uniform_real_distribution<double> step{0.5, 1.5};
+  knots.at(0) = 0.0;
+  for (size_t i{1}; i < knots_num; i++)
+  {
+    knots.at(i) = knots.at(i - 1) + step(rng);
+  }
+  std::vector<double> ctrl_pts(knots_num - degree - 1, 1.0);
+
+  // A quarter of the values, all in the first part of the input, are extrapolated
+  std::uniform_real_distribution<double> unif{knots.at(degree), knots.at(knots_num - degree - 1)};
+  std::vector<double> x_data(eval_elems);
+  std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+  std::fill_n(x_data.begin(), eval_elems / 4, knots.back() + 1.0);
+  std::vector<double> y_data(eval_elems);
+
+  BSpline<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::CONSTANT> bspline{
+      {knots}, {ctrl_pts}, degree
+  };
+
+  size_t max_threads{std::max<size_t>(parallel::default_threads(), 8)};
+  for (size_t num_threads{1}; num_threads <= max_threads; num_threads *= 2)
+  {
+    BENCHMARK(
+        "bspline.evaluate_parallel - threads: " + std::to_string(num_threads) +
+        " knots: " + std::to_string(knots_num) + " evals: " + std::to_string(eval_elems)
+    )
+    {
+      bspline.evaluate_parallel(x_data.data(), y_data.data(), x_data.size(), num_threads);
+      return y_data.back();
+    };
+  }
+}
+
+template <typename T, Curve C>
+void benchmark_isas(std::string const &type_name)
+{
+  size_t degree{3};
+  size_t knots_num{1024};
+  size_t eval_elems{100000};
+
+  std::mt19937 rng{42};
+  std::vector<T> x_data(eval_elems);
+  std::vector<T> y_data(eval_elems);
+  std::uniform_real_distribution<T> unif{(T)1, (T)1000};
+  std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+
+  BSpline<T, C, BoundaryCondition::CLAMPED, Extrapolation::CONSTANT> bspline{};
+  std::vector<T> ctrl_pts(knots_num + degree - 1, (T)1);
+  if constexpr (C == Curve::UNIFORM)
+  {
+    bspline = {{(T)0, (T)1001, knots_num}, {ctrl_pts}, degree};
+  }
+  else
+  {
+    std::vector<T> knots(knots_num);
+    for (size_t i{0}; i < knots_num; i++)
+    {
+      knots.at(i) = (T)1001 * std::sqrt((T)i / (T)(knots_num - 1));
+    }
+    bspline = {{knots}, {ctrl_pts}, degree};
+  }
+
+  std::vector<std::pair<Isa, std::string>> isas{
+      {Isa::SCALAR, "scalar"}, {Isa::SSE, "sse"}, {Isa::AVX2, "avx2"}, {Isa::AVX512, "avx512"}
+  };
+  for (auto const &[isa, name] : isas)
+  {
+    bspline.set_isa(isa);
+    if (bspline.get_isa() != isa)
+    {
+      // Not supported by this CPU
+      continue;
+    }
+    BENCHMARK(
+        "bspline.evaluate_batch - " + type_name + " isa: " + name +
+        " knots: " + std::to_string(knots_num) + " evals: " + std::to_string(eval_elems)
+    )
+    {
+      bspline.evaluate(x_data.data(), y_data.data(), x_data.size());
+      return y_data.back();
+    };
+  }
+}
+
+TEST_CASE(
+    "benchmark simd kernels for bspline::BSpline<T, C, BoundaryCondition::CLAMPED, "
+    "Extrapolation::CONSTANT>",
+    "[bspline]"
+)
+{
+  benchmark_isas<double, Curve::UNIFORM>("double uniform");
+  benchmark_isas<double, Curve::NON_UNIFORM>("double non-uniform");
+  benchmark_isas<float, Curve::UNIFORM>("float uniform");
+  benchmark_isas<float, Curve::NON_UNIFORM>("float non-uniform");
+}
+
+TEST_CASE(
+    "benchmark design matrix assembly for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::CLAMPED, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{4096};
+  size_t eval_elems{(size_t)1 << 14};
+
+  std::mt19937 rng{42};
+  std::vector<double> knots(knots_num);
+  std::uniform_real_distribution<double> step{0.5, 1.5};
+  knots.at(0) = 0.0;
+  for (size_t i{1}; i < knots_num; i++)
+  {
+    knots.at(i) = knots.at(i - 1) + step(rng);
+  }
+  std::vector<double> ctrl_pts(knots_num + degree - 1, 1.0);
+
+  std::uniform_real_distribution<double> unif{knots.front(), knots.back()};
+  std::vector<double> x_data(eval_elems);
+  std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+  std::sort(x_data.begin(), x_data.end());
+
+  BSpline<double, Curve::NON_UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::NONE> bspline{
+      {knots}, {ctrl_pts}, degree
+  };
+  size_t num_cols{ctrl_pts.size()};
+
+  // Element by element assembly, as `fit` used to do
+  BENCHMARK(
+      "bspline.design_matrix coeffRef - knots: " + std::to_string(knots_num) +
+      " evals: " + std::to_string(eval_elems)
+  )
+  {
+    std::vector<double> nnz(degree + 1);
+    Eigen::SparseMatrix<double> A(x_data.size(), num_cols);
+    A.reserve(num_cols * (degree + 1));
+    for (size_t i{0}; i < x_data.size(); i++)
+    {
+      size_t index = bspline.basis(x_data.at(i), nnz.begin());
+      for (size_t j{0}; j <= degree; j++)
+      {
+        A.coeffRef(i, j + index) += nnz.at(j);
+      }
+    }
+    A.makeCompressed();
+    return A.nonZeros();
+  };
+
+  size_t max_threads{std::max<size_t>(parallel::default_threads(), 4)};
+  for (size_t num_threads{1}; num_threads <= max_threads; num_threads *= 2)
+  {
+    BENCHMARK(
+        "bspline.design_matrix csr - threads: " + std::to_string(num_threads) +
+        " knots: " + std::to_string(knots_num) + " evals: " + std::to_string(eval_elems)
+    )
+    {
+      return bspline.design_matrix(x_data, num_threads).nnz();
+    };
+  }
+
+  BENCHMARK(
+      "bspline.design_matrix csc - knots: " + std::to_string(knots_num) +
+      " evals: " + std::to_string(eval_elems)
+  )
+  {
+    return bspline.design_matrix<Eigen::ColMajor>(x_data, 1).nnz();
+  };
+}
+
+TEST_CASE(
+    "benchmark least-squares fit for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::CLAMPED, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{1024};
+
+  std::mt19937 rng{42};
+  std::vector<double> knots(knots_num);
+  std::uniform_real_distribution<double> step{0.5, 1.5};
+  knots.at(0) = 0.0;
+  for (size_t i{1}; i < knots_num; i++)
+  {
+    knots.at(i) = knots.at(i - 1) + step(rng);
+  }
+  std::vector<double> ctrl_pts(knots_num + degree - 1, 1.0);
+  BSpline<double, Curve::NON_UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::NONE> bspline{
+      {knots}, {ctrl_pts}, degree
+  };
+
+  std::uniform_real_distribution<double> unif{knots.front(), knots.back()};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  for (size_t eval_elems : {(size_t)10000, (size_t)100000, (size_t)1000000})
+  {
+    std::vector<double> x_data(eval_elems);
+    std::vector<double> y_data(eval_elems);
+    for (size_t i{0}; i < eval_elems; i++)
+    {
+      x_data.at(i) = unif(rng);
+      y_data.at(i) = std::sin(x_data.at(i)) + noise(rng);
+    }
+
+    BENCHMARK(
+        "bspline.fit banded - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      bspline.fit(x_data, y_data);
+      return bspline.get_control_points().at(0);
+    };
+
+    // Rows folded in arrival order, as `fit` did before grouping the samples by knot interval
+    BENCHMARK(
+        "bspline.fit row by row - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      Fitter fitter{bspline};
+      fitter.add(x_data, y_data);
+      fitter.finalize();
+      return bspline.get_control_points().at(0);
+    };
+
+    // Parallel assembly of the normal equations
+    size_t max_threads{eval_elems >= 100000 ? std::max<size_t>(parallel::default_threads(), 4) : 1};
+    for (size_t num_threads{2}; num_threads <= max_threads; num_threads *= 2)
+    {
+      BENCHMARK(
+          "bspline.fit banded - threads: " + std::to_string(num_threads) +
+          " knots: " + std::to_string(knots_num) + " points: " + std::to_string(eval_elems)
+      )
+      {
+        bspline.fit(x_data, y_data, num_threads);
+        return bspline.get_control_points().at(0);
+      };
+    }
+
+    PreparedFit prepared{bspline, x_data};
+    BENCHMARK(
+        "bspline.fit prepared - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      prepared.fit(y_data);
+      return bspline.get_control_points().at(0);
+    };
+
+    if (eval_elems > 10000)
+    {
+      continue;
+    }
+
+    // What `fit` used to do above `DENSE_MAX_COL` columns
+    BENCHMARK(
+        "bspline.fit sparse qr - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      Eigen::SparseMatrix<double> A = bspline.design_matrix<Eigen::ColMajor>(x_data, 1).map();
+      Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver{};
+      solver.compute(A);
+      Eigen::VectorXd res = solver.solve(Eigen::Map<Eigen::VectorXd>(y_data.data(), y_data.size()));
+      return res(0);
+    };
+  }
+}
+
+TEST_CASE(
+    "benchmark smoothing fit for bspline::BSpline<double, Curve::UNIFORM, "
+    "BoundaryCondition::CLAMPED, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{1024};
+
+  std::vector<double> ctrl_pts(knots_num + degree - 1, 0.0);
+  BSpline<double, Curve::UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::NONE> bspline{
+      {0.0, 100.0, knots_num}, {ctrl_pts}, degree
+  };
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.0, 100.0};
+  std::normal_distribution<double> noise{0.0, 0.3};
+  for (size_t eval_elems : {(size_t)10000, (size_t)1000000})
+  {
+    std::vector<double> x_data(eval_elems);
+    std::vector<double> y_data(eval_elems);
+    for (size_t i{0}; i < eval_elems; i++)
+    {
+      x_data.at(i) = unif(rng);
+      y_data.at(i) = std::sin(x_data.at(i)) + noise(rng);
+    }
+
+    std::string const sizes{
+        " knots: " + std::to_string(knots_num) + " points: " + std::to_string(eval_elems)
+    };
+
+    BENCHMARK("bspline.fit smoothing assembly -" + sizes)
+    {
+      SmoothingFit smoothing{bspline, x_data, y_data};
+      return smoothing.get_normal_equations().rows();
+    };
+
+    // Independent of the number of points once assembled
+    SmoothingFit smoothing{bspline, x_data, y_data};
+    BENCHMARK("bspline.fit smoothing one criterion evaluation -" + sizes)
+    {
+      return smoothing.gcv(1.0);
+    };
+    BENCHMARK("bspline.fit smoothing GCV selection -" + sizes)
+    {
+      return smoothing.fit(Smoothing::GCV);
+    };
+    BENCHMARK("bspline.fit smoothing REML selection -" + sizes)
+    {
+      return smoothing.fit(Smoothing::REML);
+    };
+  }
+}
+
+TEST_CASE(
+    "benchmark multi-channel fit for bspline::BSpline<double, Curve::UNIFORM, "
+    "BoundaryCondition::CLAMPED, Extrapolation::NONE>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{256};
+  size_t eval_elems{10000};
+  size_t num_channels{500};
+
+  std::vector<double> ctrl_pts(knots_num + degree - 1, 0.0);
+  BSpline<double, Curve::UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::NONE> bspline{
+      {0.0, 1.0, knots_num}, {ctrl_pts}, degree
+  };
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.0, 1.0};
+  std::vector<double> x_data(eval_elems);
+  std::generate(x_data.begin(), x_data.end(), [&]() { return unif(rng); });
+  Eigen::MatrixXd y_data{eval_elems, num_channels};
+  for (Eigen::Index q{0}; q < y_data.cols(); q++)
+  {
+    for (Eigen::Index i{0}; i < y_data.rows(); i++)
+    {
+      y_data(i, q) = std::sin((double)(q + 1) * x_data.at(i)) + unif(rng);
+    }
+  }
+
+  std::string const sizes{
+      " knots: " + std::to_string(knots_num) + " points: " + std::to_string(eval_elems) +
+      " channels: " + std::to_string(num_channels)
+  };
+
+  BENCHMARK("bspline.fit one channel at a time -" + sizes)
+  {
+    std::vector<double> y(eval_elems);
+    for (Eigen::Index q{0}; q < y_data.cols(); q++)
+    {
+      std::copy(y_data.col(q).data(), y_data.col(q).data() + eval_elems, y.begin());
+      bspline.fit(x_data, y);
+    }
+    return bspline.get_control_points().at(0);
+  };
+
+  BENCHMARK("bspline.fit prepared all channels -" + sizes)
+  {
+    PreparedFit prepared{bspline, x_data, 1};
+    Eigen::MatrixXd res = prepared.solve(y_data);
+    return res(0, 0);
+  };
+}
+
+TEST_CASE(
+    "benchmark least-squares fit for bspline::BSpline<double, Curve::NON_UNIFORM, "
+    "BoundaryCondition::PERIODIC, Extrapolation::PERIODIC>",
+    "[bspline]"
+)
+{
+  size_t degree{3};
+  size_t knots_num{1024};
+
+  std::mt19937 rng{42};
+  std::vector<double> knots(knots_num);
+  std::uniform_real_distribution<double> step{0.5, 1.5};
+  knots.at(0) = 0.0;
+  for (size_t i{1}; i < knots_num; i++)
+  {
+    knots.at(i) = knots.at(i - 1) + step(rng);
+  }
+  std::vector<double> ctrl_pts(knots_num - 1, 1.0);
+  types::PeriodicNonUniform<double> bspline{{knots}, {ctrl_pts}, degree};
+
+  std::uniform_real_distribution<double> unif{knots.front(), knots.back()};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  for (size_t eval_elems : {(size_t)10000, (size_t)100000, (size_t)1000000})
+  {
+    std::vector<double> x_data(eval_elems);
+    std::vector<double> y_data(eval_elems);
+    for (size_t i{0}; i < eval_elems; i++)
+    {
+      x_data.at(i) = unif(rng);
+      y_data.at(i) = std::sin(x_data.at(i)) + noise(rng);
+    }
+
+    BENCHMARK(
+        "bspline.fit cyclic banded - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      bspline.fit(x_data, y_data);
+      return bspline.get_control_points().at(0);
+    };
+
+    if (eval_elems > 10000)
+    {
+      continue;
+    }
+
+    // What `fit` used to do with periodic curves
+    BENCHMARK(
+        "bspline.fit sparse qr - knots: " + std::to_string(knots_num) +
+        " points: " + std::to_string(eval_elems)
+    )
+    {
+      Eigen::SparseMatrix<double> A = bspline.design_matrix<Eigen::ColMajor>(x_data, 1).map();
+      Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver{};
+      solver.compute(A);
+      Eigen::VectorXd res = solver.solve(Eigen::Map<Eigen::VectorXd>(y_data.data(), y_data.size()));
+      return res(0);
+    };
+  }
+}
+
+TEST_CASE("benchmark interpolation for bspline::BSpline<double, Curve::UNIFORM, ...>", "[bspline]")
+{
+  size_t degree{3};
+
+  for (size_t knots_num : {(size_t)1000, (size_t)10000, (size_t)100000})
+  {
+    // Clamped, one sample in the middle of the inner knots of each support
+    std::vector<double> ctrl_pts(knots_num + degree - 1, 0.0);
+    types::ClampedUniform<double> clamped{
+        {0.0, (double)(knots_num - 1), knots_num}, {ctrl_pts}, degree
+    };
+    std::vector<double> x_data(ctrl_pts.size());
+    std::vector<double> y_data(ctrl_pts.size());
+    for (size_t i{0}; i < x_data.size(); i++)
+    {
+      double const first{std::max((double)i - (double)degree + 1.0, 0.0)};
+      double const last{std::min((double)i, (double)(knots_num - 1))};
+      x_data.at(i) = std::min((first + last) / 2.0, std::nextafter((double)(knots_num - 1), 0.0));
+      y_data.at(i) = std::sin(x_data.at(i));
+    }
+
+    BENCHMARK("bspline.interpolate clamped - knots: " + std::to_string(knots_num))
+    {
+      clamped.interpolate(x_data, y_data);
+      return clamped.get_control_points().at(0);
+    };
+
+    if (knots_num <= 10000)
+    {
+      // What `fit` used to do with as many samples as control points
+      BENCHMARK("bspline.interpolate clamped sparse qr - knots: " + std::to_string(knots_num))
+      {
+        Eigen::SparseMatrix<double> A = clamped.design_matrix<Eigen::ColMajor>(x_data, 1).map();
+        Eigen::SparseQR<Eigen::SparseMatrix<double>, Eigen::COLAMDOrdering<int>> solver{};
+        solver.compute(A);
+        Eigen::VectorXd res =
+            solver.solve(Eigen::Map<Eigen::VectorXd>(y_data.data(), y_data.size()));
+        return res(0);
+      };
+    }
+
+    // Periodic, sampled at the knots, the rows of the last samples wrap around
+    std::vector<double> periodic_ctrl_pts(knots_num - 1, 0.0);
+    types::PeriodicUniform<double> periodic{
+        {0.0, (double)(knots_num - 1), knots_num}, {periodic_ctrl_pts}, degree
+    };
+    std::vector<double> periodic_x(periodic_ctrl_pts.size());
+    std::vector<double> periodic_y(periodic_ctrl_pts.size());
+    for (size_t i{0}; i < periodic_x.size(); i++)
+    {
+      periodic_x.at(i) = (double)i;
+      periodic_y.at(i) = std::sin((double)i);
+    }
+
+    BENCHMARK("bspline.interpolate periodic - knots: " + std::to_string(knots_num))
+    {
+      periodic.interpolate(periodic_x, periodic_y);
+      return periodic.get_control_points().at(0);
+    };
+  }
+}
+
+TEST_CASE("benchmark circulant fit for bspline::BSpline<double, Curve::UNIFORM, ...>", "[bspline]")
+{
+  size_t degree{3};
+  size_t samples_per_interval{4};
+
+  for (size_t knots_num : {(size_t)1000, (size_t)10000, (size_t)100000})
+  {
+    // Periodic, a regular grid of samples over one period
+    std::vector<double> ctrl_pts(knots_num - 1, 0.0);
+    types::PeriodicUniform<double> periodic{
+        {0.0, (double)(knots_num - 1), knots_num}, {ctrl_pts}, degree
+    };
+    std::vector<double> x_data(ctrl_pts.size() * samples_per_interval);
+    std::vector<double> y_data(x_data.size());
+    for (size_t i{0}; i < x_data.size(); i++)
+    {
+      x_data.at(i) = (double)i / (double)samples_per_interval;
+      y_data.at(i) = std::sin(x_data.at(i)) + 0.1 * std::cos(7.0 * x_data.at(i));
+    }
+
+    CirculantFit circulant{periodic, x_data};
+
+    BENCHMARK("bspline.fit circulant - knots: " + std::to_string(knots_num))
+    {
+      circulant.fit(y_data);
+      return periodic.get_control_points().at(0);
+    };
+
+    BENCHMARK("bspline.fit circulant smoothing - knots: " + std::to_string(knots_num))
+    {
+      circulant.fit(y_data, 1.0);
+      return periodic.get_control_points().at(0);
+    };
+
+    // `fit` recognizes the grid on every call
+    BENCHMARK("bspline.fit - knots: " + std::to_string(knots_num))
+    {
+      periodic.fit(x_data, y_data);
+      return periodic.get_control_points().at(0);
+    };
+  }
+}
+
+TEST_CASE("benchmark window fit for bspline::BSpline<double, Curve::UNIFORM, ...>", "[bspline]")
+{
+  size_t degree{3};
+  double const dx{0.1};
+
+  for (size_t knots_num : {(size_t)1000, (size_t)10000, (size_t)100000})
+  {
+    // Ten samples per knot interval over the whole domain
+    std::vector<double> ctrl_pts(knots_num - degree - 1, 0.0);
+    types::OpenUniform<double> bspline{
+        {0.0, (double)(knots_num - 1), knots_num}, {ctrl_pts}, degree
+    };
+    types::OpenUniform<double> refit{bspline};
+    std::vector<double> x_data{};
+    std::vector<double> y_data{};
+    for (double x{(double)degree + dx / 2}; x < (double)(knots_num - 1 - degree); x += dx)
+    {
+      x_data.push_back(x);
+      y_data.push_back(std::sin(x));
+    }
+
+    WindowFitter window{bspline};
+    window.add(x_data, y_data);
+    double x{x_data.back() + dx};
+
+    // Samples past the end slide the knots, a hundred per run
+    BENCHMARK("bspline.window add - knots: " + std::to_string(knots_num))
+    {
+      for (size_t i{0}; i < 100; i++, x += dx)
+      {
+        window.add(x, std::sin(x));
+      }
+      return window.size();
+    };
+
+    BENCHMARK("bspline.window finalize - knots: " + std::to_string(knots_num))
+    {
+      window.finalize();
+      return bspline.get_control_points().at(0);
+    };
+
+    // What every tick costs without the window fitter
+    BENCHMARK("bspline.fit whole window - knots: " + std::to_string(knots_num))
+    {
+      refit.fit(x_data, y_data);
+      return refit.get_control_points().at(0);
+    };
+  }
+}
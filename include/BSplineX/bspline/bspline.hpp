@@ -2,7 +2,13 @@
 #define BSPLINE_HPP
 
 // Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 // Third-party includes
@@ -26,16 +32,40 @@
 #endif
 
 // BSplineX includes
+#include "BSplineX/bspline/design_matrix.hpp"
 #include "BSplineX/control_points/control_points.hpp"
+#include "BSplineX/deboor/deboor.hpp"
 #include "BSplineX/defines.hpp"
 #include "BSplineX/knots/knots.hpp"
+#include "BSplineX/linalg/banded_lu.hpp"
+#include "BSplineX/linalg/circulant.hpp"
+#include "BSplineX/linalg/normal_equations.hpp"
+#include "BSplineX/parallel/parallel.hpp"
+#include "BSplineX/simd/simd.hpp"
 #include "BSplineX/types.hpp"
 
-constexpr size_t DENSE_MAX_COL = 512;
+constexpr size_t DENSE_MAX_COL  = 512;
+constexpr size_t FIT_CHUNK_SIZE = 1024;
 
 namespace bsplinex::bspline
 {
 
+// Throws unless `weights` holds one finite, non-negative weight per sample
+template <typename T>
+void check_weights(std::vector<T> const &weights, size_t num_samples)
+{
+  if (weights.size() != num_samples)
+  {
+    throw std::runtime_error("The weights must have as many values as the samples");
+  }
+  if (std::any_of(
+          weights.begin(), weights.end(), [](T w) { return !(w >= (T)0) || !std::isfinite(w); }
+      ))
+  {
+    throw std::runtime_error("The weights must be finite and non-negative");
+  }
+}
+
 template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
 class BSpline
 {
@@ -43,7 +73,7 @@ private:
   knots::Knots<T, C, BC, EXT> knots{};
   control_points::ControlPoints<T, BC> control_points{};
   size_t degree{0};
-  std::vector<T> support{};
+  Isa isa{simd::resolve_isa(Isa::AUTO)};
 
 public:
   BSpline() { DEBUG_LOG_CALL(); }
@@ -57,19 +87,18 @@ public:
   {
     DEBUG_LOG_CALL();
     this->check_sizes();
-    this->support.resize(this->degree + 1);
   }
 
   BSpline(BSpline const &other)
       : knots(other.knots), control_points(other.control_points), degree(other.degree),
-        support(other.support)
+        isa(other.isa)
   {
     DEBUG_LOG_CALL();
   }
 
   BSpline(BSpline &&other) noexcept
       : knots(std::move(other.knots)), control_points(std::move(other.control_points)),
-        degree(other.degree), support(std::move(other.support))
+        degree(other.degree), isa(other.isa)
   {
     DEBUG_LOG_CALL();
   }
@@ -84,7 +113,7 @@ public:
     knots          = other.knots;
     control_points = other.control_points;
     degree         = other.degree;
-    support        = other.support;
+    isa            = other.isa;
     return *this;
   }
 
@@ -96,85 +125,482 @@ public:
     knots          = std::move(other.knots);
     control_points = std::move(other.control_points);
     degree         = other.degree;
-    support        = std::move(other.support);
+    isa            = other.isa;
     return *this;
   }
 
-  T evaluate(T value)
+  T evaluate(T value) const
   {
     auto index_value_pair = this->knots.find(value);
-    return this->deboor(index_value_pair.first, index_value_pair.second);
+    return deboor::dispatch<T>(
+        this->degree,
+        [&](auto &kernel)
+        {
+          return kernel.evaluate(
+              this->knots.data(), this->control_points, index_value_pair.first, index_value_pair.second
+          );
+        }
+    );
+  }
+
+  std::vector<T> evaluate(std::vector<T> const &values) const
+  {
+    std::vector<T> results(values.size());
+    this->evaluate(values.data(), results.data(), values.size());
+    return results;
   }
 
-  std::vector<T> basis(T value)
+  void evaluate(T const *values, T *results, size_t num_values) const
   {
-    std::vector<T> basis_functions(this->degree + 1, (T)0);
+    this->evaluate_batch<false>(values, results, num_values);
+  }
 
-    size_t index = this->compute_basis(value, basis_functions.begin(), basis_functions.end());
+  /**
+   * Batch evaluation for sorted, or nearly sorted, values. Each knot interval search starts from
+   * the previous one, so the lookup is amortised O(1) per value; values that jump around simply
+   * fall back to a logarithmic search.
+   */
+  std::vector<T> evaluate_ordered(std::vector<T> const &values) const
+  {
+    std::vector<T> results(values.size());
+    this->evaluate_ordered(values.data(), results.data(), values.size());
+    return results;
+  }
 
-    basis_functions.insert(basis_functions.begin(), index, (T)0);
-    basis_functions.insert(
-        basis_functions.end(), this->control_points.size() - index - this->degree - 1, (T)0
+  void evaluate_ordered(T const *values, T *results, size_t num_values) const
+  {
+    this->evaluate_batch<true>(values, results, num_values);
+  }
+
+  /**
+   * Batch evaluation spread over `num_threads` threads (0 for one per hardware thread). The values
+   * are cut into chunks of `PARALLEL_CHUNK_SIZE` that idle threads claim on demand, see
+   * `parallel::for_each_chunk`. Results are identical to `evaluate`, whatever the thread count.
+   */
+  std::vector<T> evaluate_parallel(std::vector<T> const &values, size_t num_threads = 0) const
+  {
+    std::vector<T> results(values.size());
+    this->evaluate_parallel(values.data(), results.data(), values.size(), num_threads);
+    return results;
+  }
+
+  void evaluate_parallel(
+      T const *values, T *results, size_t num_values, size_t num_threads = 0
+  ) const
+  {
+    parallel::for_each_chunk(
+        num_values,
+        PARALLEL_CHUNK_SIZE,
+        num_threads,
+        [&](size_t first, size_t last)
+        { this->evaluate_batch<false>(values + first, results + first, last - first); }
     );
+  }
+
+  // Dense basis, one entry per control point, see the sparse `basis` below to avoid the zeros
+  std::vector<T> basis(T value) const
+  {
+    std::vector<T> basis_functions(this->control_points.size(), (T)0);
+
+    auto index_value_pair = this->knots.find(value);
+    this->compute_basis(index_value_pair, basis_functions.begin() + index_value_pair.first + 1);
 
     return basis_functions;
   }
 
-  void fit(std::vector<T> const &x, std::vector<T> const &y)
+  /**
+   * Sparse basis. Writes the `degree + 1` basis functions that can be non-zero at `value` to
+   * `[nnz, nnz + degree + 1[` and returns the index of the control point multiplying the first one.
+   * With `BoundaryCondition::PERIODIC` the index refers to the padded control points, wrap it
+   * modulo `get_control_points().size() - degree` to get the unpadded one.
+   */
+  template <typename It>
+  size_t basis(T value, It nnz) const
+  {
+    auto index_value_pair = this->knots.find(value);
+    this->compute_basis(index_value_pair, nnz + this->degree + 1);
+    return index_value_pair.first - this->degree;
+  }
+
+  // Sparse basis of many values, `nnz` holds `degree + 1` values per value, one after the other
+  void basis(T const *values, size_t num_values, size_t *indices, T *nnz) const
+  {
+    size_t const stride{this->degree + 1};
+    deboor::dispatch<T>(
+        this->degree,
+        [&](auto &kernel)
+        {
+          for (size_t i{0}; i < num_values; i++)
+          {
+            auto index_value_pair = this->knots.find(values[i]);
+            kernel.basis(
+                this->knots.data(),
+                index_value_pair.first,
+                index_value_pair.second,
+                nnz + (i + 1) * stride
+            );
+            indices[i] = index_value_pair.first - this->degree;
+          }
+        }
+    );
+  }
+
+  /**
+   * Design matrix `A(i, j) = B_j(x_i)` of the points `x`, one row per point and one column per
+   * (unpadded) control point, in row major (CSR) storage or column major (CSC) with
+   * `Eigen::ColMajor`. Rows are built over chunks of `PARALLEL_CHUNK_SIZE` points, in parallel only
+   * when asked: `num_threads` threads, 0 for one per hardware thread, and on the calling thread by
+   * default, like `fit`. Rows do not depend on each other, so large inputs are worth building in
+   * parallel and the matrix is the same whatever the thread count. Only `evaluate_parallel`, which
+   * exists to run in parallel, defaults to every hardware thread.
+   */
+  template <int Options = Eigen::RowMajor>
+  DesignMatrix<T, Options> design_matrix(std::vector<T> const &x, size_t num_threads = 1) const
+  {
+    return this->design_matrix<Options>(x.data(), x.size(), num_threads);
+  }
+
+  template <int Options = Eigen::RowMajor>
+  DesignMatrix<T, Options> design_matrix(T const *x, size_t num_x, size_t num_threads = 1) const
+  {
+    size_t const stride{this->degree + 1};
+    size_t const num_cols{this->num_columns()};
+    if (num_cols < stride)
+    {
+      throw std::runtime_error("The design matrix needs at least degree + 1 columns");
+    }
+
+    DesignMatrix<T, Eigen::RowMajor> csr{num_x, num_cols, stride};
+    int *outer = csr.outer_index();
+    int *inner = csr.inner_index();
+    T *values  = csr.values();
+
+    // Every row owns the fixed slice `[i * stride, (i + 1) * stride[`, chunks are independent
+    parallel::for_each_chunk(
+        num_x,
+        PARALLEL_CHUNK_SIZE,
+        num_threads,
+        [&](size_t first, size_t last)
+        {
+          std::vector<size_t> indices(last - first);
+          this->basis(x + first, last - first, indices.data(), values + first * stride);
+
+          for (size_t i{first}; i < last; i++)
+          {
+            size_t const index{indices[i - first]};
+            size_t const offset{i * stride};
+            outer[i] = static_cast<int>(offset);
+
+            if (index + stride <= num_cols)
+            {
+              for (size_t j{0}; j < stride; j++)
+              {
+                inner[offset + j] = static_cast<int>(index + j);
+              }
+              continue;
+            }
+
+            // Periodic wrap: the last `stride - split` entries belong to the first columns, rotate
+            // them to the front to keep the columns sorted
+            size_t const split{num_cols - index};
+            std::rotate(values + offset, values + offset + split, values + offset + stride);
+            for (size_t j{0}; j < stride; j++)
+            {
+              inner[offset + j] =
+                  static_cast<int>(j < stride - split ? j : index + j - (stride - split));
+            }
+          }
+        }
+    );
+    outer[num_x] = static_cast<int>(num_x * stride);
+
+    if constexpr (Options == Eigen::RowMajor)
+    {
+      return csr;
+    }
+    else
+    {
+      return to_col_major(csr);
+    }
+  }
+
+  /**
+   * Least-squares fit of the control points to the samples `(x, y)`. The banded normal equations
+   * are assembled over `num_threads` threads (0 for one per hardware thread), each summing a
+   * contiguous block of samples, and merged in block order, so the result is bitwise reproducible
+   * for a given number of threads.
+   */
+  void fit(std::vector<T> const &x, std::vector<T> const &y, size_t num_threads = 1)
   {
     if (x.size() != y.size())
     {
       throw std::runtime_error("x and y must have the same size");
     }
 
-    // NOTE: bertolazzi says that the LU algorithm uses roughly half the computations as QR. it is
-    // less stable, but for a band matrix it may be fine. plus he suggests to sort the input points
-    // as that may improve performance substantially, especially if we develop a specialised LU band
-    // algorithm.
+    this->least_squares(x.data(), y.data(), nullptr, x.size(), num_threads);
+  }
 
-    std::vector<T> nnz_basis(this->degree + 1, (T)0);
-    Eigen::Map<Eigen::VectorX<T> const> b(y.data(), y.size());
-    Eigen::VectorX<T> res;
-    size_t num_cols{this->control_points.size()};
-    if constexpr (BC == BoundaryCondition::PERIODIC)
+  /**
+   * Weighted least-squares fit, minimizing `sum_i w[i] * (y[i] - s(x[i]))^2`: integer weights
+   * count as repeated samples and zero weights drop them. The weights scale the rows during the
+   * assembly, `x` and `y` are never copied. Throws unless there is one finite, non-negative weight
+   * per sample.
+   */
+  void fit(
+      std::vector<T> const &x,
+      std::vector<T> const &y,
+      std::vector<T> const &w,
+      size_t num_threads = 1
+  )
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    check_weights(w, x.size());
+
+    this->least_squares(x.data(), y.data(), w.data(), x.size(), num_threads);
+  }
+
+  /**
+   * Control points of the B-spline through the samples `(x, y)`, one sample per free control point
+   * (all but the `degree` repeated ones of periodic curves). The square collocation matrix is
+   * banded once the samples are sorted by knot interval, cyclic-banded for periodic curves, and
+   * solved in `O(n * degree^2)`. Throws when the samples do not determine the control points, e.g.
+   * when two of them coincide or too many fall in the same knot interval.
+   */
+  void interpolate(std::vector<T> const &x, std::vector<T> const &y)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    if (x.size() != this->num_columns())
     {
-      num_cols -= this->degree;
+      throw std::runtime_error("Interpolation needs exactly one sample per free control point");
     }
 
-    if (num_cols <= DENSE_MAX_COL)
+    std::vector<T> res(x.size());
+    if (!this->collocate(x.data(), y.data(), res.data()))
     {
-      Eigen::MatrixX<T> A = Eigen::MatrixX<T>::Zero(x.size(), num_cols);
+      throw std::runtime_error(
+          "The samples do not determine the control points, they must spread over the knot "
+          "intervals (Schoenberg-Whitney conditions)"
+      );
+    }
+    this->control_points.set_data(res);
+  }
 
-      size_t index{0};
-      for (size_t i{0}; i < x.size(); i++)
+  /**
+   * Uniform periodic curves only. When `x` is a regular grid over exactly one period, in increasing
+   * order and with the same number of samples in every knot interval, the design matrix is made of
+   * circulant blocks and the fit is solved with FFTs, see `linalg::CirculantLeastSquares`. Returns
+   * that system with its spectra computed, nothing when `x` is not such a grid. Unless the curve
+   * extrapolates periodically the grid must also lie in the domain, the wrapped samples would
+   * otherwise stand for a model other than the one the curve evaluates.
+   */
+  std::optional<linalg::CirculantLeastSquares<T>> circulant(std::vector<T> const &x) const
+  {
+    return this->circulant(x.data(), x.size());
+  }
+
+  std::optional<linalg::CirculantLeastSquares<T>> circulant(T const *x, size_t num_x) const
+  {
+    static_assert(
+        C == Curve::UNIFORM && BC == BoundaryCondition::PERIODIC,
+        "Only uniform periodic curves have circulant design matrices"
+    );
+
+    size_t const num_cols{this->num_columns()};
+    if (num_x == 0 || num_x % num_cols != 0)
+    {
+      return std::nullopt;
+    }
+
+    auto const [left, right] = this->knots.domain();
+    if constexpr (EXT != Extrapolation::PERIODIC)
+    {
+      for (size_t i{0}; i < num_x; i++)
       {
-        index = this->compute_basis(x.at(i), nnz_basis.begin(), nnz_basis.end());
-        for (size_t j{0}; j <= this->degree; j++)
+        if (!(x[i] >= left && x[i] < right))
         {
-          // TODO: avoid modulo
-          A(i, (j + index) % num_cols) += nnz_basis.at(j);
+          return std::nullopt;
         }
-        std::fill(nnz_basis.begin(), nnz_basis.end(), (T)0);
       }
+    }
 
-      res = A.colPivHouseholderQr().solve(b);
+    // x[i] = x[0] + i * period / num_x, to rounding
+    T const step{(right - left) / static_cast<T>(num_x)};
+    T const tolerance{
+        (T)16 * std::numeric_limits<T>::epsilon() * (std::abs(x[0]) + (right - left))
+    };
+    for (size_t i{1}; i < num_x; i++)
+    {
+      if (!(std::abs(x[i] - x[0] - static_cast<T>(i) * step) <= tolerance))
+      {
+        return std::nullopt;
+      }
+    }
+
+    // The first `num_blocks` samples are all it takes, the next ones repeat them one knot interval
+    // further
+    size_t const num_blocks{num_x / num_cols};
+    size_t const width{this->degree + 1};
+    std::vector<T> kernels(num_blocks * width);
+    std::vector<size_t> shifts(num_blocks);
+    for (size_t r{0}; r < num_blocks; r++)
+    {
+      shifts[r] = this->basis(x[r], kernels.begin() + r * width);
+    }
+    return linalg::CirculantLeastSquares<T>{
+        num_cols, width, kernels.data(), shifts.data(), num_blocks
+    };
+  }
+
+  /**
+   * The banded normal equations `B^T W B c = B^T W y` of the fit of `(x, y)`, with unit weights
+   * when `w` is empty, assembled as `fit` does over `num_threads` threads. They are the starting
+   * point of fits that change the equations before solving, e.g. with a penalty. Periodic curves
+   * get them over their padded control points, the last `degree` columns aliasing the first ones:
+   * solve those with `solve_periodic(x, get_control_points().size() - get_degree())`.
+   */
+  linalg::NormalEquations<T> normal_equations(
+      std::vector<T> const &x,
+      std::vector<T> const &y,
+      std::vector<T> const &w = {},
+      size_t num_threads      = 1
+  ) const
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    if (!w.empty())
+    {
+      check_weights(w, x.size());
+    }
+    return this->assemble(
+        x.data(), y.data(), w.empty() ? nullptr : w.data(), x.size(), num_threads
+    );
+  }
+
+  // Replaces the control points, `data` has as many as the B-spline was constructed with
+  void set_control_points(std::vector<T> const &data)
+  {
+    if (data.size() != this->num_columns())
+    {
+      throw std::runtime_error("The number of control points must not change");
+    }
+    this->control_points.set_data(data);
+  }
+
+  control_points::ControlPoints<T, BC> const &get_control_points() const
+  {
+    return this->control_points;
+  }
+
+  knots::Knots<T, C, BC, EXT> const &get_knots() const { return this->knots; }
+
+  // Knot search policy used by non-uniform curves, see `knots/t_search.hpp`. With `Search::BUCKET`,
+  // `num_buckets` sets the size of the index (0 for one bucket per knot interval)
+  void set_search(Search search, size_t num_buckets = 0)
+  {
+    this->knots.set_search(search, num_buckets);
+  }
+
+  [[nodiscard]] Search get_search() const { return this->knots.get_search(); }
+
+  [[nodiscard]] size_t get_num_buckets() const { return this->knots.get_num_buckets(); }
+
+  // Bytes used by the search policy on top of the knots themselves
+  [[nodiscard]] size_t search_memory() const { return this->knots.search_memory(); }
+
+  // Instruction set of the batch kernels, see `simd/simd.hpp`. Defaults to the best one the CPU
+  // supports, `Isa::SCALAR` selects the reference kernels
+  void set_isa(Isa isa) { this->isa = simd::resolve_isa(isa); }
+
+  [[nodiscard]] Isa get_isa() const { return this->isa; }
+
+  [[nodiscard]] size_t get_degree() const { return this->degree; }
+
+private:
+  // Columns of the design matrix, periodic curves repeat the first `degree` control points
+  [[nodiscard]] size_t num_columns() const
+  {
+    if constexpr (BC == BoundaryCondition::PERIODIC)
+    {
+      return this->control_points.size() - this->degree;
     }
     else
     {
-      Eigen::SparseMatrix<T> A(x.size(), num_cols);
-      A.reserve(num_cols * (this->degree + 1));
+      return this->control_points.size();
+    }
+  }
 
-      size_t index{0};
-      for (size_t i{0}; i < x.size(); i++)
+  // Weights `w` may be null, meaning all ones
+  void least_squares(T const *x, T const *y, T const *w, size_t num_x, size_t num_threads)
+  {
+    // Uniform periodic curves sampled on a grid have circulant systems, solved with FFTs
+    if constexpr (C == Curve::UNIFORM && BC == BoundaryCondition::PERIODIC)
+    {
+      std::optional<linalg::CirculantLeastSquares<T>> system{};
+      if (w == nullptr && (system = this->circulant(x, num_x)))
       {
-        index = this->compute_basis(x.at(i), nnz_basis.begin(), nnz_basis.end());
-        for (size_t j{0}; j <= this->degree; j++)
+        std::vector<T> res(this->num_columns());
+        if (system->solve(y, res.data()))
         {
-          A.coeffRef(i, (j + index) % num_cols) += nnz_basis.at(j);
+          this->control_points.set_data(res);
+          return;
         }
-        std::fill(nnz_basis.begin(), nnz_basis.end(), (T)0);
       }
-      A.makeCompressed();
+    }
+
+    // As many samples as unknowns, with positive weights the fit interpolates
+    if (num_x == this->num_columns() &&
+        (w == nullptr || std::all_of(w, w + num_x, [](T weight) { return weight > (T)0; })))
+    {
+      std::vector<T> res(num_x);
+      if (this->collocate(x, y, res.data()))
+      {
+        this->control_points.set_data(res);
+        return;
+      }
+    }
+
+    if (this->fit_banded(x, y, w, num_x, num_threads))
+    {
+      return;
+    }
+
+    // General QR, also copes with rank deficient systems, e.g. knot intervals without any data.
+    // Weights scale the rows of `B` and `y` by their square roots, in the freshly built design
+    // matrix and right-hand side
+    DesignMatrix<T> design = this->design_matrix(x, num_x, 1);
+    Eigen::VectorX<T> b    = Eigen::Map<Eigen::VectorX<T> const>(y, num_x);
+    if (w != nullptr)
+    {
+      size_t const stride{this->degree + 1};
+      for (size_t i{0}; i < num_x; i++)
+      {
+        T const scale{std::sqrt(w[i])};
+        std::for_each(
+            design.values() + i * stride,
+            design.values() + (i + 1) * stride,
+            [scale](T &value) { value *= scale; }
+        );
+        b(i) *= scale;
+      }
+    }
+
+    Eigen::VectorX<T> res;
+    if (this->num_columns() <= DENSE_MAX_COL)
+    {
+      Eigen::MatrixX<T> A = design.map().toDense();
+      res                 = A.colPivHouseholderQr().solve(b);
+    }
+    else
+    {
+      Eigen::SparseMatrix<T> A = to_col_major(design).map();
 
       Eigen::SparseQR<Eigen::SparseMatrix<T>, Eigen::COLAMDOrdering<int>> solver{};
       solver.compute(A);
@@ -182,13 +608,260 @@ public:
     }
 
     this->control_points.set_data({res.data(), res.data() + res.rows() * res.cols()});
+  }
 
-    return;
+  // Least squares through the banded normal equations, see `assemble`, cyclic-banded once folded
+  // for periodic curves. Returns false when they are too ill-conditioned, e.g. when some control
+  // points have no data in their support
+  bool fit_banded(T const *x, T const *y, T const *w, size_t num_x, size_t num_threads)
+  {
+    std::vector<T> res(this->num_columns());
+    linalg::NormalEquations<T> const equations{this->assemble(x, y, w, num_x, num_threads)};
+    bool solved{false};
+    if constexpr (BC == BoundaryCondition::PERIODIC)
+    {
+      solved = equations.solve_periodic(res.data(), this->num_columns());
+    }
+    else
+    {
+      solved = equations.solve(res.data());
+    }
+    if (!solved)
+    {
+      return false;
+    }
+    this->control_points.set_data(res);
+    return true;
+  }
+
+  // The banded normal equations `B^T W B c = B^T W y`, see `linalg::NormalEquations`, without
+  // forming the design matrix `B`. Periodic curves get them over their padded control points, with
+  // no wrap-around, the last `degree` columns alias the first ones
+  linalg::NormalEquations<T>
+  assemble(T const *x, T const *y, T const *w, size_t num_x, size_t num_threads) const
+  {
+    // One block and one set of partial normal equations per thread, a static partition keeps the
+    // summation order independent of the scheduling
+    size_t num_blocks{num_threads == 0 ? parallel::default_threads() : num_threads};
+    num_blocks = std::max<size_t>(std::min(num_blocks, num_x / FIT_CHUNK_SIZE), 1);
+    size_t const block_size{std::max<size_t>((num_x + num_blocks - 1) / num_blocks, 1)};
+
+    std::vector<linalg::NormalEquations<T>> partial(
+        num_blocks, linalg::NormalEquations<T>{this->control_points.size(), this->degree + 1}
+    );
+    parallel::for_each_chunk(
+        num_x,
+        block_size,
+        num_blocks,
+        [&](size_t first, size_t last)
+        {
+          this->accumulate(
+              partial[first / block_size],
+              x + first,
+              y + first,
+              w == nullptr ? nullptr : w + first,
+              last - first
+          );
+        }
+    );
+    for (size_t b{1}; b < num_blocks; b++)
+    {
+      partial[0].add(partial[b]);
+    }
+    return std::move(partial[0]);
   }
 
-  control_points::ControlPoints<T, BC> const &get_control_points() { return this->control_points; }
+  // Solves the square collocation system `B c = y`, returns false when `B` is singular
+  bool collocate(T const *x, T const *y, T *res) const
+  {
+    size_t const stride{this->degree + 1};
+    size_t const num_cols{this->num_columns()};
+    if (num_cols < stride)
+    {
+      return false;
+    }
+
+    std::vector<size_t> indices(num_cols);
+    std::vector<T> nnz(num_cols * stride);
+    this->basis(x, num_cols, indices.data(), nnz.data());
+
+    // Rows sorted by first column with a counting sort, the matrix is then banded
+    std::vector<size_t> offsets(num_cols + 1, 0);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      offsets[indices[i] + 1]++;
+    }
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      offsets[k + 1] += offsets[k];
+    }
+    std::vector<size_t> order(num_cols);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      order[offsets[indices[i]]++] = i;
+    }
+
+    // Periodic rows are rotated by `degree / 2` so that the middle of their support, where the
+    // basis is largest, lies on the diagonal. The factorization does not pivot across the border,
+    // with the first entry of each row on the diagonal it would be unstable. Rows wrapping past the
+    // last column then go to the border rows, entries wrapping before the first column to the
+    // border columns
+    size_t border{0};
+    if constexpr (BC == BoundaryCondition::PERIODIC)
+    {
+      std::rotate(order.begin(), order.end() - (ptrdiff_t)(this->degree / 2), order.end());
+
+      auto const n    = (ptrdiff_t)num_cols;
+      auto const half = n / 2;
+      for (ptrdiff_t r{0}; r < n; r++)
+      {
+        auto const first = (ptrdiff_t)indices[order[r]];
+        for (ptrdiff_t j{0}; j < (ptrdiff_t)stride; j++)
+        {
+          ptrdiff_t const c{(first + j) % n};
+          ptrdiff_t const unwrapped{r + (c - r + n + half) % n - half};
+          if (unwrapped >= n)
+          {
+            border = std::max(border, (size_t)(n - r));
+          }
+          else if (unwrapped < 0)
+          {
+            border = std::max(border, (size_t)(n - c));
+          }
+        }
+      }
+    }
+
+    // Every entry of the leading rows and columns is now close to the diagonal
+    size_t const lead{num_cols - border};
+    size_t lower{0};
+    size_t upper{0};
+    for (size_t r{0}; r < lead; r++)
+    {
+      for (size_t j{0}; j < stride; j++)
+      {
+        size_t const c{(indices[order[r]] + j) % num_cols};
+        if (c < lead)
+        {
+          lower = std::max(lower, r > c ? r - c : 0);
+          upper = std::max(upper, c > r ? c - r : 0);
+        }
+      }
+    }
+
+    linalg::BandedLU<T> collocation{num_cols, lower, upper, border};
+    for (size_t r{0}; r < num_cols; r++)
+    {
+      size_t const i{order[r]};
+      for (size_t j{0}; j < stride; j++)
+      {
+        collocation.at(r, (indices[i] + j) % num_cols) += nnz[i * stride + j];
+      }
+      res[r] = y[i];
+    }
+    if (!collocation.factorize())
+    {
+      return false;
+    }
+    collocation.solve(res);
+    return true;
+  }
+
+  // Samples grouped by knot interval with a counting sort, O(1) per sample on top of the knot
+  // search. Every interval is then handled in one go: its samples share the basis polynomials of
+  // the interval and their rows of the normal equations are summed in a small dense block, written
+  // once to the band
+  void accumulate(
+      linalg::NormalEquations<T> &equations, T const *x, T const *y, T const *w, size_t num_x
+  ) const
+  {
+    size_t const stride{this->degree + 1};
+    size_t const num_buckets{this->num_columns()};
+
+    // The basis is evaluated at the values `find` extrapolates into the domain, as `evaluate` does
+    std::vector<size_t> offsets(num_buckets + 1, 0);
+    std::vector<size_t> buckets(num_x);
+    std::vector<T> values(num_x);
+    for (size_t i{0}; i < num_x; i++)
+    {
+      auto const found = this->knots.find(x[i]);
+      buckets[i]       = found.first - this->degree;
+      values[i]        = found.second;
+      offsets[buckets[i] + 1]++;
+    }
+    for (size_t b{0}; b < num_buckets; b++)
+    {
+      offsets[b + 1] += offsets[b];
+    }
+
+    std::vector<std::pair<T, T>> sorted(num_x);
+    std::vector<size_t> next{offsets.begin(), offsets.end() - 1};
+    std::vector<T> sorted_w(w == nullptr ? 0 : num_x);
+    for (size_t i{0}; i < num_x; i++)
+    {
+      size_t const k{next[buckets[i]]++};
+      sorted[k] = {values[i], y[i]};
+      if (w != nullptr)
+      {
+        sorted_w[k] = w[i];
+      }
+    }
+
+    // Scratch space, on the heap only for degrees too large for the stack
+    size_t const scratch_size{stride * (2 * stride + 2) + 1};
+    std::vector<T> heap(this->degree > STACK_MAX_DEGREE ? scratch_size : 0);
+    deboor::dispatch<T>(
+        this->degree,
+        [&](auto &kernel)
+        {
+          auto const p = kernel.get_static_degree();
+          auto const n = p + 1;
+
+          // On the stack, the fixed-degree kernels then keep the polynomials of the interval, the
+          // basis and the block sums in registers across its samples
+          T stack[(STACK_MAX_DEGREE + 1) * (2 * STACK_MAX_DEGREE + 4) + 1];
+          T *coeffs  = p <= STACK_MAX_DEGREE ? stack : heap.data();
+          T *block   = coeffs + n * n;
+          T *rhs     = block + n * n;
+          T *squares = rhs + n;
+          T *nnz     = squares + 1;
+
+          for (size_t b{0}; b < num_buckets; b++)
+          {
+            if (offsets[b] == offsets[b + 1])
+            {
+              continue;
+            }
+
+            // The samples of an interval share its basis polynomials, computed once so that each
+            // sample costs a Horner sweep instead of the divisions of the recurrence
+            size_t const index{b + this->degree};
+            deboor::basis_polynomials(p, this->knots.data(), index, coeffs);
+            T const left{this->knots.data()[index]};
+            T const scale{(T)1 / (this->knots.data()[index + 1] - left)};
+
+            std::fill_n(block, n * n + n + 1, (T)0);
+            for (size_t k{offsets[b]}; k < offsets[b + 1]; k++)
+            {
+              deboor::basis_at(p, coeffs, (sorted[k].first - left) * scale, nnz + n);
+              T const weight{w == nullptr ? (T)1 : sorted_w[k]};
+              *squares += weight * sorted[k].second * sorted[k].second;
+              for (size_t i{0}; i < n; i++)
+              {
+                T const scaled{weight * nnz[i]};
+                rhs[i] += scaled * sorted[k].second;
+                for (size_t j{i}; j < n; j++)
+                {
+                  block[i * n + j] += scaled * nnz[j];
+                }
+              }
+            }
+            equations.add_block(b, block, rhs, squares, offsets[b + 1] - offsets[b]);
+          }
+        }
+    );
+  }
 
-private:
   void check_sizes()
   {
     if (this->control_points.size() == this->knots.size() - this->degree - 1)
@@ -223,57 +896,94 @@ private:
     throw std::runtime_error(ss.str());
   }
 
-  T deboor(size_t index, T value)
+  template <bool ORDERED>
+  void evaluate_batch(T const *values, T *results, size_t num_values) const
   {
-    for (size_t j = 0; j <= this->degree; j++)
-    {
-      this->support[j] = this->control_points.at(j + index - this->degree);
-    }
-
-    T alpha = 0;
-    for (size_t r = 1; r <= this->degree; r++)
-    {
-      for (size_t j = this->degree; j >= r; j--)
-      {
-        alpha = (value - this->knots.at(j + index - this->degree)) /
-                (this->knots.at(j + 1 + index - r) - this->knots.at(j + index - this->degree));
-        this->support[j] = (1.0 - alpha) * this->support[j - 1] + alpha * this->support[j];
-      }
-    }
-
-    return this->support[this->degree];
+    deboor::dispatch<T>(
+        this->degree,
+        [&](auto &kernel)
+        {
+          size_t indices[EVALUATE_BATCH_SIZE];
+          T reduced[EVALUATE_BATCH_SIZE];
+          size_t hint{this->degree};
+          T const *knots_data = this->knots.data();
+
+          // Uniform knots only need the domain and the step to locate a value
+          auto [value_left, value_right] = this->knots.domain();
+          T step_size_inv{(T)1 / (knots_data[this->degree + 1] - knots_data[this->degree])};
+          size_t index_last{this->knots.size() - this->degree - 2};
+
+          for (size_t first{0}; first < num_values; first += EVALUATE_BATCH_SIZE)
+          {
+            size_t count = std::min(EVALUATE_BATCH_SIZE, num_values - first);
+
+            // First locate all the knot intervals, then run de Boor on the whole batch. Values
+            // that need no extrapolation are used as they are.
+            T const *located = reduced;
+            if constexpr (C == Curve::UNIFORM)
+            {
+              if (simd::find_uniform(
+                      this->isa,
+                      values + first,
+                      count,
+                      value_left,
+                      value_right,
+                      step_size_inv,
+                      this->degree,
+                      index_last,
+                      indices
+                  ))
+              {
+                located = values + first;
+              }
+            }
+
+            for (size_t i{0}; located == reduced && i < count; i++)
+            {
+              std::pair<size_t, T> index_value_pair{};
+              if constexpr (ORDERED)
+              {
+                index_value_pair = this->knots.find_ordered(values[first + i], hint);
+                hint             = index_value_pair.first;
+              }
+              else
+              {
+                index_value_pair = this->knots.find(values[first + i]);
+              }
+              indices[i] = index_value_pair.first;
+              reduced[i] = index_value_pair.second;
+            }
+
+            if (!simd::deboor(
+                    this->isa,
+                    kernel.get_static_degree(),
+                    knots_data,
+                    this->knots.size(),
+                    this->control_points,
+                    indices,
+                    located,
+                    count,
+                    results + first
+                ))
+            {
+              kernel.evaluate(
+                  knots_data, this->control_points, indices, located, count, results + first
+              );
+            }
+          }
+        }
+    );
   }
 
+  // Writes the non-zero basis functions in `[end - degree - 1, end[`, no need to zero them first
   template <typename It>
-  size_t compute_basis(T value, [[maybe_unused]] It begin, It end)
+  void compute_basis(std::pair<size_t, T> const &index_value_pair, It end) const
   {
-    assertm((end - begin) == (long long)(this->degree + 1), "Unexpected number of basis asked");
-
-    assertm(
-        std::all_of(begin, end, [](T i) { return (T)0 == i; }),
-        "Initial basis must be initialised to zero"
+    deboor::dispatch<T>(
+        this->degree,
+        [&](auto &kernel)
+        { kernel.basis(this->knots.data(), index_value_pair.first, index_value_pair.second, end); }
     );
-
-    auto [index, val] = this->knots.find(value);
-
-    // assertm(begin + index < end, "Index outside of boundaries");
-
-    *(end - 1) = 1.0;
-    for (size_t d{1}; d <= this->degree; d++)
-    {
-      *(end - 1 - d) = (knots.at(index + 1) - val) /
-                       (knots.at(index + 1) - knots.at(index - d + 1)) * *(end - 1 - d + 1);
-      for (size_t i{index - d + 1}; i < index; i++)
-      {
-        *(end - 1 - index + i) =
-            (val - knots.at(i)) / (knots.at(i + d) - knots.at(i)) * *(end - 1 - index + i) +
-            (knots.at(i + d + 1) - val) / (knots.at(i + d + 1) - knots.at(i + 1)) *
-                *(end - 1 - index + i + 1);
-      }
-      *(end - 1) = (val - knots.at(index)) / (knots.at(index + d) - knots.at(index)) * *(end - 1);
-    }
-
-    return index - this->degree;
   }
 };
 
@@ -0,0 +1,125 @@
+#ifndef BSPLINE_CIRCULANT_HPP
+#define BSPLINE_CIRCULANT_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/circulant.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Interpolation, least-squares and smoothing fits of a uniform periodic B-spline to data sampled
+ * on a regular grid over one period, e.g. angle-indexed signals, solved with FFTs.
+ *
+ * With the same number of samples in every knot interval the design matrix is made of circulant
+ * blocks, see `BSpline::circulant`. Their spectra are computed once at construction, every later
+ * fit costs a few FFTs, `O(N log n)` for `N` samples and `n` control points, without building any
+ * matrix. One sample per knot interval interpolates. The smoothing fit penalizes the squared
+ * cyclic `order`-th differences of the control points (periodic P-splines).
+ *
+ * The circulant fit stores a pointer to the B-spline, which must outlive it, and a copy of its
+ * knots and degree. `fit` and `solve` throw once either changes, prepare a new one in that case.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class CirculantFit
+{
+  static_assert(
+      C == Curve::UNIFORM && BC == BoundaryCondition::PERIODIC,
+      "Only uniform periodic curves have circulant design matrices"
+  );
+
+private:
+  BSpline<T, C, BC, EXT> *bspline{nullptr};
+  linalg::CirculantLeastSquares<T> system{};
+  std::vector<T> knots{};
+  size_t degree{0};
+  size_t order{0};
+
+public:
+  CirculantFit() = default;
+
+  /**
+   * Prepares the fits of data sampled at `x`. Throws unless `x` is a regular grid over exactly one
+   * period, in increasing order, with the same number of samples in every knot interval, and in
+   * the domain unless the curve extrapolates periodically.
+   */
+  CirculantFit(BSpline<T, C, BC, EXT> &bspline, std::vector<T> const &x, size_t order = 2)
+      : bspline{&bspline},
+        knots{bspline.get_knots().data(), bspline.get_knots().data() + bspline.get_knots().size()},
+        degree{bspline.get_degree()}, order{order}
+  {
+    auto prepared = bspline.circulant(x);
+    if (!prepared)
+    {
+      throw std::runtime_error(
+          "x must be a regular grid over one period, with as many samples in every knot interval"
+      );
+    }
+    this->system = std::move(*prepared);
+  }
+
+  /**
+   * Fits the B-spline to `y`, sampled at the prepared `x`, with the smoothing parameter `lambda`,
+   * 0 being plain least squares. Throws when `lambda` is negative or the system is singular, e.g.
+   * when interpolating at the midpoints of the knot intervals with odd degree and an even number
+   * of control points.
+   */
+  void fit(std::vector<T> const &y, T lambda = (T)0)
+  {
+    std::vector<T> res(this->system.cols());
+    this->solve(y, res.data(), lambda);
+    this->bspline->set_control_points(res);
+  }
+
+  // Same as `fit`, but writes the control points to `control_points` instead of the B-spline
+  void solve(std::vector<T> const &y, T *control_points, T lambda = (T)0) const
+  {
+    if (y.size() != this->system.rows())
+    {
+      throw std::runtime_error("y must have as many samples as the prepared x");
+    }
+    if (!(lambda >= (T)0))
+    {
+      throw std::runtime_error("The smoothing parameter must be non-negative");
+    }
+    if (!this->is_valid())
+    {
+      throw std::runtime_error("The knots changed since the fit was prepared, prepare it again");
+    }
+    if (!this->system.solve(y.data(), control_points, lambda, this->order))
+    {
+      throw std::runtime_error(
+          "The circulant system is singular, sample elsewhere in the knot intervals or smooth"
+      );
+    }
+  }
+
+  // False once the knots or the degree of the B-spline differ from the prepared ones
+  [[nodiscard]] bool is_valid() const
+  {
+    if (this->bspline == nullptr || this->bspline->get_degree() != this->degree)
+    {
+      return false;
+    }
+    auto const &current = this->bspline->get_knots();
+    return current.size() == this->knots.size() &&
+           std::equal(this->knots.begin(), this->knots.end(), current.data());
+  }
+
+  // Number of samples the fit was prepared for
+  [[nodiscard]] size_t size() const { return this->system.rows(); }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
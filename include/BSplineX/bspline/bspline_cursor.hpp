@@ -0,0 +1,68 @@
+#ifndef BSPLINE_CURSOR_HPP
+#define BSPLINE_CURSOR_HPP
+
+// Standard includes
+#include <cstddef>
+#include <utility>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/deboor/deboor.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Evaluation cursor for streams of values that arrive one at a time, each close to the previous
+ * one. The cursor remembers the last knot interval and starts the next search from there
+ * (see `knots::Finder::find_ordered`), so slowly moving values are located in constant time.
+ *
+ * The cursor only stores a pointer to the B-spline, which must outlive it, and an index. It never
+ * allocates for degrees up to `STACK_MAX_DEGREE` and only throws where `BSpline::evaluate` would,
+ * i.e. outside of the domain with `Extrapolation::NONE`. Use one cursor per thread.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class Cursor
+{
+private:
+  BSpline<T, C, BC, EXT> const *bspline{nullptr};
+  size_t index{0};
+
+public:
+  Cursor() = default;
+
+  Cursor(BSpline<T, C, BC, EXT> const &bspline) : bspline{&bspline}, index{bspline.get_degree()}
+  {
+  }
+
+  T evaluate(T value)
+  {
+    assertm(this->bspline != nullptr, "Cursor not bound to a B-spline");
+
+    auto const &knots     = this->bspline->get_knots();
+    auto index_value_pair = knots.find_ordered(value, this->index);
+    this->index           = index_value_pair.first;
+
+    return deboor::dispatch<T>(
+        this->bspline->get_degree(),
+        [&](auto &kernel)
+        {
+          return kernel.evaluate(
+              knots.data(),
+              this->bspline->get_control_points(),
+              index_value_pair.first,
+              index_value_pair.second
+          );
+        }
+    );
+  }
+
+  // Knot interval of the last evaluated value
+  [[nodiscard]] size_t get_index() const { return this->index; }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef BSPLINE_FITTER_HPP
+#define BSPLINE_FITTER_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/io/mapped_file.hpp"
+#include "BSplineX/linalg/normal_equations.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Incremental least-squares fit of the control points of a B-spline, for data sets that do not fit
+ * in memory or arrive over time.
+ *
+ * Samples, optionally weighted, are fed in chunks of any size with `add` or `add_file` and folded
+ * into the banded normal equations of the B-spline's knots (see `linalg::NormalEquations`), then
+ * forgotten. The state is `O(n * degree)` for `n` control points however many samples are added.
+ * `finalize` solves and writes the control points to the B-spline, the samples stay accumulated so
+ * more can be added and `finalize` called again. Periodic curves accumulate over their padded
+ * control points, folded into a cyclic-banded system when solving.
+ *
+ * The fitter stores a pointer to the B-spline, which must outlive it and keep its knots.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class Fitter
+{
+private:
+  BSpline<T, C, BC, EXT> *bspline{nullptr};
+  linalg::NormalEquations<T> equations{};
+
+  // Scratch space for a chunk of samples
+  std::vector<size_t> indices{};
+  std::vector<T> nnz{};
+  std::vector<T> pairs{};
+
+public:
+  Fitter() = default;
+
+  Fitter(BSpline<T, C, BC, EXT> &bspline)
+      : bspline{&bspline},
+        equations{bspline.get_control_points().size(), bspline.get_degree() + 1},
+        indices(FIT_CHUNK_SIZE), nnz(FIT_CHUNK_SIZE * (bspline.get_degree() + 1))
+  {
+  }
+
+  void add(T const *x, T const *y, size_t num_samples) { this->add(x, y, nullptr, num_samples); }
+
+  // Weighted samples, see `BSpline::fit(x, y, w)`, `w` may be null for unit weights
+  void add(T const *x, T const *y, T const *w, size_t num_samples)
+  {
+    assertm(this->bspline != nullptr, "Fitter not bound to a B-spline");
+
+    size_t const stride{this->bspline->get_degree() + 1};
+    for (size_t first{0}; first < num_samples; first += FIT_CHUNK_SIZE)
+    {
+      size_t const count{std::min(FIT_CHUNK_SIZE, num_samples - first)};
+      this->bspline->basis(x + first, count, this->indices.data(), this->nnz.data());
+      for (size_t i{0}; i < count; i++)
+      {
+        this->equations.add_row(
+            this->indices[i],
+            this->nnz.data() + i * stride,
+            y + first + i,
+            w == nullptr ? (T)1 : w[first + i]
+        );
+      }
+    }
+  }
+
+  void add(std::vector<T> const &x, std::vector<T> const &y)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    this->add(x.data(), y.data(), x.size());
+  }
+
+  void add(std::vector<T> const &x, std::vector<T> const &y, std::vector<T> const &w)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    check_weights(w, x.size());
+    this->add(x.data(), y.data(), w.data(), x.size());
+  }
+
+  /**
+   * Adds every sample of a binary file of native `T` pairs `x0 y0 x1 y1 ...`. The file is memory
+   * mapped (see `io::MappedFile`) and read sequentially one chunk at a time.
+   */
+  void add_file(std::string const &path)
+  {
+    io::MappedFile file{path};
+    if (file.size() % (2 * sizeof(T)) != 0)
+    {
+      throw std::runtime_error(path + " does not hold a whole number of (x, y) pairs");
+    }
+
+    size_t const num_samples{file.size() / (2 * sizeof(T))};
+    this->pairs.resize(2 * FIT_CHUNK_SIZE);
+    T *x = this->pairs.data();
+    T *y = this->pairs.data() + FIT_CHUNK_SIZE;
+    for (size_t first{0}; first < num_samples; first += FIT_CHUNK_SIZE)
+    {
+      size_t const count{std::min(FIT_CHUNK_SIZE, num_samples - first)};
+      char const *bytes = file.data() + first * 2 * sizeof(T);
+      for (size_t i{0}; i < count; i++)
+      {
+        std::memcpy(x + i, bytes + (2 * i) * sizeof(T), sizeof(T));
+        std::memcpy(y + i, bytes + (2 * i + 1) * sizeof(T), sizeof(T));
+      }
+      this->add(x, y, count);
+    }
+  }
+
+  /**
+   * Solves for the control points and writes them to the B-spline. Throws when the samples do not
+   * determine them, e.g. when some control point has no sample in its support.
+   */
+  void finalize()
+  {
+    assertm(this->bspline != nullptr, "Fitter not bound to a B-spline");
+
+    bool solved{false};
+    std::vector<T> res{};
+    if constexpr (BC == BoundaryCondition::PERIODIC)
+    {
+      res.resize(this->equations.cols() - this->bspline->get_degree());
+      solved = this->equations.solve_periodic(res.data(), res.size());
+    }
+    else
+    {
+      res.resize(this->equations.cols());
+      solved = this->equations.solve(res.data());
+    }
+    if (!solved)
+    {
+      throw std::runtime_error(
+          "The samples do not determine the control points, some knot intervals lack data"
+      );
+    }
+    this->bspline->set_control_points(res);
+  }
+
+  // Drops every sample added so far
+  void reset() { this->equations.reset(); }
+
+  // Number of samples added so far
+  [[nodiscard]] size_t size() const { return this->equations.rows(); }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -0,0 +1,256 @@
+#ifndef BSPLINE_PREPARED_FIT_HPP
+#define BSPLINE_PREPARED_FIT_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Core>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/bspline/design_matrix.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/banded_cholesky.hpp"
+#include "BSplineX/linalg/cyclic_banded_cholesky.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Least-squares fit of a B-spline to many data sets sampled at the same points `x`.
+ *
+ * The design matrix `B` of `x` and the Cholesky factor of `B^T B` are computed once at
+ * construction. Every later fit only forms `B^T y` and runs two banded triangular solves, i.e.
+ * `O(N * p + n * p)` for `N` samples and `n` control points instead of a full assembly and
+ * factorization. `B` is kept in CSR form, `O(N * p)` memory.
+ *
+ * Several data sets sharing `x` are fitted together, with a single pass over `B`, by `solve(y)` and
+ * `fit(y, bsplines)` with one data set per column of `y`.
+ *
+ * The rows of periodic curves wrap around the last control points, `B^T B` is then cyclic-banded
+ * and factorized with `linalg::CyclicBandedCholesky` at the same cost.
+ *
+ * The prepared fit stores a pointer to the B-spline, which must outlive it, and a copy of its
+ * knots and degree. It is invalidated as soon as either changes, e.g. when the B-spline is
+ * assigned another one: `is_valid` tells, and `fit` and `solve` throw instead of returning control
+ * points for the wrong basis. Prepare a new one in that case.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class PreparedFit
+{
+private:
+  using Factor = std::conditional_t<
+      BC == BoundaryCondition::PERIODIC,
+      linalg::CyclicBandedCholesky<T>,
+      linalg::BandedCholesky<T>>;
+
+  BSpline<T, C, BC, EXT> *bspline{nullptr};
+  DesignMatrix<T> design{};
+  Factor factor{};
+  std::vector<T> knots{};
+  size_t degree{0};
+
+public:
+  PreparedFit() = default;
+
+  /**
+   * Builds and factorizes the normal equations of `x`, building the design matrix over
+   * `num_threads` threads, one unless asked for more (see `BSpline::design_matrix`). Throws when
+   * `x` does not determine the control points, e.g. when some control point has no sample in its
+   * support.
+   */
+  PreparedFit(BSpline<T, C, BC, EXT> &bspline, std::vector<T> const &x, size_t num_threads = 1)
+      : bspline{&bspline}, design{bspline.design_matrix(x, num_threads)},
+        factor{this->design.cols(), bspline.get_degree() + 1},
+        knots{bspline.get_knots().data(), bspline.get_knots().data() + bspline.get_knots().size()},
+        degree{bspline.get_degree()}
+  {
+    for (size_t i{0}; i < this->design.rows(); i++)
+    {
+      this->add_outer(i, (T)1);
+    }
+
+    if (!this->factor.factorize())
+    {
+      throw std::runtime_error(
+          "The samples do not determine the control points, some knot intervals lack data"
+      );
+    }
+  }
+
+  /**
+   * Same as above for the weighted fit of `BSpline::fit(x, y, w)`. The weights are folded into the
+   * stored rows, `W B`, so later fits cost the same as unweighted ones. Throws unless there is one
+   * finite, non-negative weight per sample.
+   */
+  PreparedFit(
+      BSpline<T, C, BC, EXT> &bspline,
+      std::vector<T> const &x,
+      std::vector<T> const &w,
+      size_t num_threads = 1
+  )
+      : bspline{&bspline}, design{bspline.design_matrix(x, num_threads)},
+        factor{this->design.cols(), bspline.get_degree() + 1},
+        knots{bspline.get_knots().data(), bspline.get_knots().data() + bspline.get_knots().size()},
+        degree{bspline.get_degree()}
+  {
+    check_weights(w, x.size());
+
+    // `B^T W B` from the rows of `B`, which are then replaced by those of `W B` so that `solve`
+    // forms `B^T W y`
+    size_t const stride{this->degree + 1};
+    for (size_t i{0}; i < this->design.rows(); i++)
+    {
+      this->add_outer(i, w[i]);
+      T *row = this->design.values() + i * stride;
+      std::for_each(row, row + stride, [&](T &value) { value *= w[i]; });
+    }
+
+    if (!this->factor.factorize())
+    {
+      throw std::runtime_error(
+          "The samples do not determine the control points, some knot intervals lack data"
+      );
+    }
+  }
+
+  // Fits the B-spline to `y`, sampled at the `x` (and weighted by the `w`) given at construction
+  void fit(std::vector<T> const &y)
+  {
+    std::vector<T> res(this->factor.cols());
+    this->solve(y, res.data());
+    this->bspline->set_control_points(res);
+  }
+
+  // Same as `fit`, but writes the control points to `control_points` instead of the B-spline
+  void solve(std::vector<T> const &y, T *control_points) const
+  {
+    if (y.size() != this->design.rows())
+    {
+      throw std::runtime_error("y must have as many samples as the prepared x");
+    }
+    if (!this->is_valid())
+    {
+      throw std::runtime_error("The knots changed since the fit was prepared, prepare it again");
+    }
+
+    // B^T y, or B^T W y with the weighted rows, through the CSR arrays
+    std::fill(control_points, control_points + this->factor.cols(), (T)0);
+    size_t const stride{this->degree + 1};
+    int const *inner = this->design.inner_index();
+    T const *values  = this->design.values();
+    for (size_t i{0}; i < this->design.rows(); i++)
+    {
+      for (size_t k{i * stride}; k < (i + 1) * stride; k++)
+      {
+        control_points[inner[k]] += values[k] * y[i];
+      }
+    }
+
+    this->factor.solve(control_points);
+  }
+
+  /**
+   * Fits every column of `y`, each sampled at the prepared `x`, in one pass: `B^T Y` is a single
+   * sparse-dense product and the banded triangular solves run over all the right-hand sides at
+   * once. Returns the control points, one column per data set.
+   */
+  Eigen::MatrixX<T> solve(Eigen::Ref<Eigen::MatrixX<T> const> const &y) const
+  {
+    if (static_cast<size_t>(y.rows()) != this->design.rows())
+    {
+      throw std::runtime_error("y must have as many samples as the prepared x");
+    }
+    if (!this->is_valid())
+    {
+      throw std::runtime_error("The knots changed since the fit was prepared, prepare it again");
+    }
+
+    // Row major, so that the solves sweep contiguous right-hand sides
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> rhs =
+        this->design.map().transpose() * y;
+    this->factor.solve(rhs.data(), static_cast<size_t>(rhs.cols()));
+    return rhs;
+  }
+
+  /**
+   * Same as `solve(y)`, writing the control points of column `q` to `*(bsplines + q)`. Every
+   * B-spline must have the knots and degree the fit was prepared with, otherwise this throws
+   * before writing anything.
+   */
+  template <typename It>
+  void fit(Eigen::Ref<Eigen::MatrixX<T> const> const &y, It bsplines)
+  {
+    for (Eigen::Index q{0}; q < y.cols(); q++)
+    {
+      BSpline<T, C, BC, EXT> const &target = *(bsplines + q);
+      if (!this->same_basis(target))
+      {
+        throw std::runtime_error("All B-splines must share the knots the fit was prepared with");
+      }
+    }
+
+    Eigen::MatrixX<T> res = this->solve(y);
+    for (Eigen::Index q{0}; q < y.cols(); q++)
+    {
+      T const *column = res.col(q).data();
+      (*(bsplines + q)).set_control_points({column, column + res.rows()});
+    }
+  }
+
+  // False once the knots or the degree of the B-spline differ from the prepared ones
+  [[nodiscard]] bool is_valid() const
+  {
+    return this->bspline != nullptr && this->same_basis(*this->bspline);
+  }
+
+  // Number of samples the fit was prepared for
+  [[nodiscard]] size_t size() const { return this->design.rows(); }
+
+private:
+  // `B^T B += weight * b b^T` for the row `b` of `B` at `i`
+  void add_outer(size_t i, T weight)
+  {
+    size_t const stride{this->degree + 1};
+    int const *inner = this->design.inner_index() + i * stride;
+    T const *row     = this->design.values() + i * stride;
+    if constexpr (BC == BoundaryCondition::PERIODIC)
+    {
+      // The columns of a row that wraps around are sorted but not consecutive, entry by entry
+      for (size_t a{0}; a < stride; a++)
+      {
+        T const scaled{weight * row[a]};
+        for (size_t b{a}; b < stride; b++)
+        {
+          this->factor.at(static_cast<size_t>(inner[a]), static_cast<size_t>(inner[b])) +=
+              scaled * row[b];
+        }
+      }
+    }
+    else
+    {
+      this->factor.add_outer(static_cast<size_t>(inner[0]), row, weight);
+    }
+  }
+
+  bool same_basis(BSpline<T, C, BC, EXT> const &other) const
+  {
+    if (other.get_degree() != this->degree)
+    {
+      return false;
+    }
+    auto const &current = other.get_knots();
+    return current.size() == this->knots.size() &&
+           std::equal(this->knots.begin(), this->knots.end(), current.data());
+  }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -0,0 +1,427 @@
+#ifndef BSPLINE_SMOOTHING_HPP
+#define BSPLINE_SMOOTHING_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/deboor/deboor.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/banded_cholesky.hpp"
+#include "BSplineX/linalg/normal_equations.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Penalized least-squares fit of a B-spline, minimizing
+ *
+ *   sum_i w[i] * (y[i] - s(x[i]))^2 + lambda * c^T P c
+ *
+ * over the control points `c`. `P` penalizes roughness: the squared `order`-th differences of the
+ * control points with `Penalty::DIFFERENCE` (P-splines), or the integral of the squared `order`-th
+ * derivative of the curve with `Penalty::DERIVATIVE` (smoothing splines). Both are banded, so
+ * `(B^T W B + lambda P) c = B^T W y` is as well.
+ *
+ * The normal equations are assembled once at construction, `O(N * p)` for `N` samples. Everything
+ * else only works on the `n` control points: a fit for a given `lambda` is a banded factorization
+ * and solve, `O(n * p^2)`, and so is each evaluation of the GCV and REML criteria, whose trace and
+ * determinant come from the banded factor and its selected inverse. `select` minimizes either
+ * criterion over `lambda`.
+ *
+ * The smoothing fit stores a pointer to the B-spline, which must outlive it and keep its knots.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class SmoothingFit
+{
+  static_assert(
+      BC != BoundaryCondition::PERIODIC,
+      "GCV and REML need the selected inverse of a banded factor, periodic curves fold their normal "
+      "equations into a cyclic-banded system"
+  );
+
+private:
+  // Everything the criteria need for one `lambda`
+  struct Evaluation
+  {
+    bool valid{false};
+    std::vector<T> control_points{};
+    T residuals{0};
+    T roughness{0};
+    T effective_dof{0};
+    T log_determinant{0};
+  };
+
+  BSpline<T, C, BC, EXT> *bspline{nullptr};
+  linalg::NormalEquations<T> equations{};
+  linalg::BandedCholesky<T> penalty{};
+  size_t order{0};
+
+public:
+  SmoothingFit() = default;
+
+  /**
+   * Assembles the normal equations of `(x, y)` over `num_threads` threads (see `BSpline::fit`) and
+   * the `order`-th `penalty`. Throws when the order does not penalize anything: it must be at
+   * least 1, below the number of control points for `Penalty::DIFFERENCE` and at most the degree
+   * for `Penalty::DERIVATIVE`.
+   */
+  SmoothingFit(
+      BSpline<T, C, BC, EXT> &bspline,
+      std::vector<T> const &x,
+      std::vector<T> const &y,
+      Penalty penalty    = Penalty::DIFFERENCE,
+      size_t order       = 2,
+      size_t num_threads = 1
+  )
+      : SmoothingFit{bspline, x, y, {}, penalty, order, num_threads}
+  {
+  }
+
+  // Same as above with the sample weights `w` of `BSpline::fit(x, y, w)`
+  SmoothingFit(
+      BSpline<T, C, BC, EXT> &bspline,
+      std::vector<T> const &x,
+      std::vector<T> const &y,
+      std::vector<T> const &w,
+      Penalty penalty    = Penalty::DIFFERENCE,
+      size_t order       = 2,
+      size_t num_threads = 1
+  )
+      : bspline{&bspline}, equations{bspline.normal_equations(x, y, w, num_threads)}, order{order}
+  {
+    size_t const num_cols{this->equations.cols()};
+    if (penalty == Penalty::DIFFERENCE)
+    {
+      if (order < 1 || order >= num_cols)
+      {
+        throw std::runtime_error(
+            "The difference penalty order must be at least 1 and below the number of control "
+            "points"
+        );
+      }
+      this->build_difference_penalty();
+    }
+    else
+    {
+      if (order < 1 || order > bspline.get_degree())
+      {
+        throw std::runtime_error(
+            "The derivative penalty order must be at least 1 and at most the degree"
+        );
+      }
+      this->build_derivative_penalty();
+    }
+  }
+
+  /**
+   * Fits the B-spline with the smoothing parameter `lambda`, 0 being plain least squares. Throws
+   * when `lambda` is negative or the penalized equations are singular, e.g. for `lambda = 0` with
+   * knot intervals lacking data.
+   */
+  void fit(T lambda)
+  {
+    if (!(lambda >= (T)0))
+    {
+      throw std::runtime_error("The smoothing parameter must be non-negative");
+    }
+
+    Evaluation evaluation = this->evaluate(lambda, false);
+    if (!evaluation.valid)
+    {
+      throw std::runtime_error(
+          "The penalized normal equations are singular, increase the smoothing parameter"
+      );
+    }
+    this->bspline->set_control_points(evaluation.control_points);
+  }
+
+  // Fits the B-spline with the smoothing parameter selected by `criterion`, which is returned
+  T fit(Smoothing criterion)
+  {
+    T const lambda{this->select(criterion)};
+    this->fit(lambda);
+    return lambda;
+  }
+
+  /**
+   * The smoothing parameter minimizing `criterion`. A scan over 16 decades around the ratio of the
+   * traces of `B^T W B` and `P` brackets the minimum, golden section search then refines it in
+   * `log(lambda)`.
+   */
+  [[nodiscard]] T select(Smoothing criterion = Smoothing::GCV) const
+  {
+    auto score = [&](T log_lambda) -> T
+    {
+      T const lambda{std::pow((T)10, log_lambda)};
+      return criterion == Smoothing::GCV ? this->gcv(lambda) : this->reml(lambda);
+    };
+
+    T const center{std::log10(this->trace_ratio())};
+    T const step{0.25};
+    size_t const num_steps{65};
+    size_t best{0};
+    std::vector<T> scores(num_steps);
+    for (size_t i{0}; i < num_steps; i++)
+    {
+      scores[i] = score(center + step * ((T)i - (T)(num_steps / 2)));
+      if (scores[i] < scores[best])
+      {
+        best = i;
+      }
+    }
+    if (!std::isfinite(scores[best]))
+    {
+      throw std::runtime_error("The smoothing criterion is undefined for all smoothing parameters");
+    }
+
+    T const golden{(std::sqrt((T)5) - (T)1) / (T)2};
+    T lower{center + step * ((T)std::max<size_t>(best, 1) - 1 - (T)(num_steps / 2))};
+    T upper{center + step * ((T)std::min(best + 1, num_steps - 1) - (T)(num_steps / 2))};
+    T left{upper - golden * (upper - lower)};
+    T right{lower + golden * (upper - lower)};
+    T score_left{score(left)};
+    T score_right{score(right)};
+    for (size_t iteration{0}; iteration < 40; iteration++)
+    {
+      if (score_left < score_right)
+      {
+        upper       = right;
+        right       = left;
+        score_right = score_left;
+        left        = upper - golden * (upper - lower);
+        score_left  = score(left);
+      }
+      else
+      {
+        lower       = left;
+        left        = right;
+        score_left  = score_right;
+        right       = lower + golden * (upper - lower);
+        score_right = score(right);
+      }
+    }
+
+    T const log_lambda{(lower + upper) / (T)2};
+    return score(log_lambda) <= scores[best]
+               ? std::pow((T)10, log_lambda)
+               : std::pow((T)10, center + step * ((T)best - (T)(num_steps / 2)));
+  }
+
+  /**
+   * Generalized cross-validation `N * RSS / (N - edf)^2`, `RSS` being the weighted residual sum of
+   * squares and `edf` the effective degrees of freedom. Infinite when undefined.
+   */
+  [[nodiscard]] T gcv(T lambda) const
+  {
+    Evaluation evaluation = this->evaluate(lambda, true);
+    T const num_samples{static_cast<T>(this->equations.rows())};
+    if (!evaluation.valid || !(evaluation.effective_dof < num_samples))
+    {
+      return std::numeric_limits<T>::infinity();
+    }
+    T const denominator{num_samples - evaluation.effective_dof};
+    return num_samples * evaluation.residuals / (denominator * denominator);
+  }
+
+  /**
+   * Restricted maximum likelihood, as minus twice the log-likelihood with the noise variance
+   * profiled out and constants dropped:
+   *
+   *   (N - k) * log(RSS + lambda * c^T P c) + log(det(B^T W B + lambda P)) - (n - k) * log(lambda)
+   *
+   * with `k = order` the dimension of the null space of `P`. Infinite when undefined.
+   */
+  [[nodiscard]] T reml(T lambda) const
+  {
+    T const num_samples{static_cast<T>(this->equations.rows())};
+    T const null_space{static_cast<T>(this->order)};
+    T const num_cols{static_cast<T>(this->equations.cols())};
+    Evaluation evaluation = this->evaluate(lambda, false);
+    T const deviance{evaluation.residuals + lambda * evaluation.roughness};
+    if (!evaluation.valid || !(lambda > (T)0) || !(deviance > (T)0) ||
+        !(num_samples > null_space))
+    {
+      return std::numeric_limits<T>::infinity();
+    }
+    return (num_samples - null_space) * std::log(deviance) + evaluation.log_determinant -
+           (num_cols - null_space) * std::log(lambda);
+  }
+
+  /**
+   * Effective degrees of freedom `trace((B^T W B + lambda P)^-1 B^T W B)`, from the number of
+   * control points at `lambda = 0` down to `order` as `lambda` grows. NaN when the penalized
+   * equations are singular.
+   */
+  [[nodiscard]] T effective_dof(T lambda) const
+  {
+    Evaluation evaluation = this->evaluate(lambda, true);
+    return evaluation.valid ? evaluation.effective_dof : std::numeric_limits<T>::quiet_NaN();
+  }
+
+  linalg::NormalEquations<T> const &get_normal_equations() const { return this->equations; }
+
+  // `P`, such that `c^T P c` is the roughness of the control points `c`
+  linalg::BandedCholesky<T> const &get_penalty() const { return this->penalty; }
+
+private:
+  Evaluation evaluate(T lambda, bool with_trace) const
+  {
+    linalg::BandedCholesky<T> const &gram = this->equations.get_gram();
+    size_t const num_cols{gram.cols()};
+    size_t const width{std::max(gram.bandwidth(), this->penalty.bandwidth())};
+
+    linalg::BandedCholesky<T> system{num_cols, width};
+    system.add(gram);
+    system.add(this->penalty, lambda);
+
+    Evaluation evaluation{};
+    if (!system.factorize())
+    {
+      return evaluation;
+    }
+    evaluation.valid = true;
+
+    T const *rhs = this->equations.rhs_data();
+    evaluation.control_points.assign(rhs, rhs + num_cols);
+    system.solve(evaluation.control_points.data());
+    T const *c = evaluation.control_points.data();
+
+    // RSS = y^T W y - 2 c^T B^T W y + c^T B^T W B c, clipped against rounding
+    T cross{0};
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      cross += c[k] * rhs[k];
+    }
+    evaluation.residuals = std::max(
+        this->equations.squares_data()[0] - (T)2 * cross + gram.quadratic_form(c), (T)0
+    );
+    evaluation.roughness       = this->penalty.quadratic_form(c);
+    evaluation.log_determinant = system.log_determinant();
+
+    if (with_trace)
+    {
+      // trace(Z G) with Z symmetric and G within the band of Z
+      std::vector<T> inverse = system.selected_inverse();
+      T const *g             = gram.data();
+      size_t const g_width{gram.bandwidth()};
+      T trace{0};
+      for (size_t k{0}; k < num_cols; k++)
+      {
+        trace += inverse[k * width] * g[k * g_width];
+        for (size_t j{1}; j < std::min(g_width, num_cols - k); j++)
+        {
+          trace += (T)2 * inverse[k * width + j] * g[k * g_width + j];
+        }
+      }
+      evaluation.effective_dof = trace;
+    }
+    return evaluation;
+  }
+
+  // Scale of `lambda` at which the penalty starts to matter
+  [[nodiscard]] T trace_ratio() const
+  {
+    linalg::BandedCholesky<T> const &gram = this->equations.get_gram();
+    T gram_trace{0};
+    T penalty_trace{0};
+    for (size_t k{0}; k < gram.cols(); k++)
+    {
+      gram_trace += gram.at(k, k);
+      penalty_trace += this->penalty.at(k, k);
+    }
+    return gram_trace > (T)0 && penalty_trace > (T)0 ? gram_trace / penalty_trace : (T)1;
+  }
+
+  // `D^T D`, the rows of `D` holding the binomial coefficients of the `order`-th difference
+  void build_difference_penalty()
+  {
+    size_t const num_cols{this->equations.cols()};
+    std::vector<T> difference(this->order + 1);
+    difference[0] = (T)1;
+    for (size_t k{1}; k <= this->order; k++)
+    {
+      for (size_t j{k}; j > 0; j--)
+      {
+        difference[j] = difference[j - 1] - difference[j];
+      }
+      difference[0] = -difference[0];
+    }
+
+    this->penalty = linalg::BandedCholesky<T>{num_cols, this->order + 1};
+    for (size_t r{0}; r + this->order < num_cols; r++)
+    {
+      this->penalty.add_outer(r, difference.data());
+    }
+  }
+
+  // `P(i, j) = integral of B_i^(order) B_j^(order)`, exactly, interval by interval from the
+  // polynomial form of the basis (see `deboor::basis_polynomials`)
+  void build_derivative_penalty()
+  {
+    size_t const degree{this->bspline->get_degree()};
+    size_t const n{degree + 1};
+    size_t const num_cols{this->equations.cols()};
+    T const *knots = this->bspline->get_knots().data();
+
+    this->penalty = linalg::BandedCholesky<T>{num_cols, n};
+    std::vector<T> coeffs(n * n);
+    std::vector<T> derivative(n * n);
+    std::vector<T> block(n * n);
+    for (size_t index{degree}; index < num_cols; index++)
+    {
+      T const width{knots[index + 1] - knots[index]};
+      if (!(width > (T)0))
+      {
+        continue;
+      }
+
+      // d^k/dx^k = width^-k d^k/du^k, so that u^m becomes m! / (m - k)! u^(m - k) / width^k
+      deboor::basis_polynomials(degree, knots, index, coeffs.data());
+      std::fill(derivative.begin(), derivative.end(), (T)0);
+      for (size_t m{this->order}; m < n; m++)
+      {
+        T falling{1};
+        for (size_t f{0}; f < this->order; f++)
+        {
+          falling *= static_cast<T>(m - f);
+        }
+        for (size_t j{0}; j < n; j++)
+        {
+          derivative[(m - this->order) * n + j] = falling * coeffs[m * n + j];
+        }
+      }
+
+      // The integral over the interval is width times the one over u in [0, 1]
+      T const scale{std::pow(width, (T)1 - (T)2 * static_cast<T>(this->order))};
+      size_t const num_powers{n - this->order};
+      for (size_t i{0}; i < n; i++)
+      {
+        for (size_t j{i}; j < n; j++)
+        {
+          T sum{0};
+          for (size_t a{0}; a < num_powers; a++)
+          {
+            for (size_t b{0}; b < num_powers; b++)
+            {
+              sum += derivative[a * n + i] * derivative[b * n + j] / static_cast<T>(a + b + 1);
+            }
+          }
+          block[i * n + j] = scale * sum;
+        }
+      }
+      this->penalty.add_block(index - degree, block.data());
+    }
+  }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -0,0 +1,309 @@
+#ifndef BSPLINE_WINDOW_HPP
+#define BSPLINE_WINDOW_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/banded_qr.hpp"
+#include "BSplineX/types.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Rolling least-squares fit of a B-spline to a stream of samples, e.g. a time series, over the
+ * last `span` of `x`, with knots that slide along with the data.
+ *
+ * Samples must come in non-decreasing `x`. When one lands past the end of the domain the knots
+ * slide forward by whole knot intervals: the first control point is dropped, a new last one is
+ * appended and the samples of the intervals that left the domain are forgotten. Samples older than
+ * `span` before the newest one are forgotten too, one at a time. The default infinite `span` keeps
+ * everything in the domain. A finite one must be longer than the domain less one knot interval,
+ * the first control point would otherwise run out of samples before the knots slide.
+ *
+ * Each knot interval keeps the QR factorization of its own samples, a `(p + 1) x (p + 1)` block of
+ * the banded factorization of the whole window for degree `p` (see `linalg::BandedQR`). A new
+ * sample is a Givens update of its block, a forgotten one a hyperbolic downdate of its block and a
+ * slide drops a block, so each costs `O(p^2)` whatever the length of the window, where calling
+ * `fit` on the window again costs `O(N * p^2)` for `N` samples. Blocks stay independent because
+ * downdating the leading rows of a single banded factor would sweep all the rows below them.
+ * `finalize` merges the blocks in `O(n * p^3)` for `n` control points, solves, and writes the
+ * control points and the slid knots to the B-spline. The samples in the window are kept, `O(N * p)`
+ * memory, to be taken out exactly as they went in.
+ *
+ * Only uniform open knots slide without changing the basis functions of the samples already in the
+ * window. The fitter stores a pointer to the B-spline, which must outlive it, and a copy of it to
+ * evaluate the basis at the new samples.
+ */
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class WindowFitter
+{
+  static_assert(
+      C == Curve::UNIFORM && BC == BoundaryCondition::OPEN,
+      "Only uniform open knots keep the basis of the samples when they slide"
+  );
+
+private:
+  BSpline<T, C, BC, EXT> *bspline{nullptr};
+  // The B-spline as bound, samples are evaluated on it moved back by `shifts` knot intervals
+  BSpline<T, C, BC, EXT> reference{};
+  // One factorization per knot interval, interval `g` counted from the bound knots at `g % size`
+  std::vector<linalg::BandedQR<T>> blocks{};
+  size_t degree{0};
+  size_t num_cols{0};
+  size_t num_knots{0};
+  T first_knot{0};
+  T last_knot{0};
+  T step{0};
+  T left{0};
+  T right{0};
+  T span{0};
+  size_t shifts{0};
+  T latest{-std::numeric_limits<T>::infinity()};
+
+  // Samples in the window, oldest first, by knot interval counted from the bound knots, and
+  // `degree + 1` basis values, `x`, `y` and the weight each
+  std::deque<size_t> intervals{};
+  std::deque<T> rows{};
+  std::vector<T> nnz{};
+
+public:
+  WindowFitter() = default;
+
+  WindowFitter(BSpline<T, C, BC, EXT> &bspline, T span = std::numeric_limits<T>::infinity())
+      : bspline{&bspline}, reference{bspline},
+        blocks(
+            bspline.get_control_points().size() - bspline.get_degree(),
+            linalg::BandedQR<T>{bspline.get_degree() + 1, bspline.get_degree() + 1}
+        ),
+        degree{bspline.get_degree()}, num_cols{bspline.get_control_points().size()},
+        num_knots{bspline.get_knots().size()}, first_knot{bspline.get_knots().data()[0]},
+        last_knot{bspline.get_knots().data()[bspline.get_knots().size() - 1]},
+        step{(this->last_knot - this->first_knot) / (T)(this->num_knots - 1)},
+        left{bspline.get_knots().domain().first}, right{bspline.get_knots().domain().second},
+        span{span}, nnz(bspline.get_degree() + 1)
+  {
+    if (!(span > this->right - this->left - this->step))
+    {
+      throw std::runtime_error("The span must be longer than the domain less one knot interval");
+    }
+  }
+
+  /**
+   * Adds the sample `(x, y)` with weight `w`, sliding the knots first when `x` is past the end of
+   * the domain. Throws when `x` comes before the last sample or the start of the domain, or when it
+   * is so far past the end that the number of slides is not representable.
+   */
+  void add(T x, T y, T w = (T)1)
+  {
+    assertm(this->bspline != nullptr, "Fitter not bound to a B-spline");
+
+    if (!(w >= (T)0) || !std::isfinite(w))
+    {
+      throw std::runtime_error("The weights must be finite and non-negative");
+    }
+    if (!(x >= this->latest) || !std::isfinite(x))
+    {
+      throw std::runtime_error("Samples must be finite and come in non-decreasing x");
+    }
+
+    T local{x - this->offset()};
+    if (!(local >= this->left))
+    {
+      throw std::runtime_error("x is before the start of the domain");
+    }
+    if (!(local < this->right))
+    {
+      this->slide(x);
+      local = x - this->offset();
+    }
+    this->expire(x - this->span);
+
+    size_t const interval{this->reference.basis(local, this->nnz.begin()) + this->shifts};
+    this->block(interval).add_row(0, this->nnz.data(), y, w);
+    this->intervals.push_back(interval);
+    this->rows.insert(this->rows.end(), this->nnz.begin(), this->nnz.end());
+    this->rows.push_back(x);
+    this->rows.push_back(y);
+    this->rows.push_back(w);
+    this->latest = x;
+  }
+
+  void add(T const *x, T const *y, size_t num_samples) { this->add(x, y, nullptr, num_samples); }
+
+  // Weighted samples, see `BSpline::fit(x, y, w)`, `w` may be null for unit weights
+  void add(T const *x, T const *y, T const *w, size_t num_samples)
+  {
+    for (size_t i{0}; i < num_samples; i++)
+    {
+      this->add(x[i], y[i], w == nullptr ? (T)1 : w[i]);
+    }
+  }
+
+  void add(std::vector<T> const &x, std::vector<T> const &y)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    this->add(x.data(), y.data(), x.size());
+  }
+
+  void add(std::vector<T> const &x, std::vector<T> const &y, std::vector<T> const &w)
+  {
+    if (x.size() != y.size())
+    {
+      throw std::runtime_error("x and y must have the same size");
+    }
+    check_weights(w, x.size());
+    this->add(x.data(), y.data(), w.data(), x.size());
+  }
+
+  /**
+   * Solves for the control points and writes them, with the knots slid so far, to the B-spline.
+   * Throws when the samples in the window do not determine them, e.g. when some control point has
+   * no sample in its support.
+   */
+  void finalize()
+  {
+    assertm(this->bspline != nullptr, "Fitter not bound to a B-spline");
+
+    linalg::BandedQR<T> system{this->num_cols, this->degree + 1};
+    for (size_t j{0}; j < this->blocks.size(); j++)
+    {
+      system.merge(this->block(this->shifts + j), j);
+    }
+    std::vector<T> res(this->num_cols);
+    if (!system.solve(res.data()))
+    {
+      throw std::runtime_error(
+          "The samples do not determine the control points, some knot intervals lack data"
+      );
+    }
+
+    T const offset{this->offset()};
+    BSpline<T, C, BC, EXT> slid{
+        {this->first_knot + offset, this->last_knot + offset, this->num_knots}, {res}, this->degree
+    };
+    slid.set_isa(this->bspline->get_isa());
+    slid.set_search(this->bspline->get_search(), this->bspline->get_num_buckets());
+    *this->bspline = std::move(slid);
+  }
+
+  // Drops every sample in the window, the knots stay where they slid
+  void reset()
+  {
+    for (auto &block : this->blocks)
+    {
+      block.reset();
+    }
+    this->intervals.clear();
+    this->rows.clear();
+    this->latest = -std::numeric_limits<T>::infinity();
+  }
+
+  // Current domain, i.e. the domain of the B-spline once `finalize` is called
+  [[nodiscard]] std::pair<T, T> domain() const
+  {
+    return {this->left + this->offset(), this->right + this->offset()};
+  }
+
+  // Number of samples in the window
+  [[nodiscard]] size_t size() const { return this->intervals.size(); }
+
+private:
+  [[nodiscard]] T offset() const { return static_cast<T>(this->shifts) * this->step; }
+
+  linalg::BandedQR<T> &block(size_t interval)
+  {
+    return this->blocks[interval % this->blocks.size()];
+  }
+
+  [[nodiscard]] size_t stride() const { return this->degree + 4; }
+
+  void pop_front()
+  {
+    this->intervals.pop_front();
+    this->rows.erase(this->rows.begin(), this->rows.begin() + this->stride());
+  }
+
+  // Slides the knots forward until `x` is in the domain, forgetting the samples that leave it
+  void slide(T x)
+  {
+    // Counted in `T`, a far jump can take more slides than `size_t` holds
+    T count{std::floor((x - this->offset() - this->right) / this->step) + (T)1};
+    T shifted{static_cast<T>(this->shifts) + count};
+    if (!(x - shifted * this->step < this->right))
+    {
+      // Rounding left `x` one interval short
+      count++;
+      shifted++;
+    }
+    T const local{x - shifted * this->step};
+    if (!(shifted < static_cast<T>(std::numeric_limits<size_t>::max())) ||
+        !(local >= this->left && local < this->right))
+    {
+      throw std::runtime_error("x is too far past the domain to slide the knots to it");
+    }
+
+    if (!(count < static_cast<T>(this->blocks.size())))
+    {
+      this->reset();
+      this->shifts = static_cast<size_t>(shifted);
+      return;
+    }
+
+    for (size_t c{0}; c < static_cast<size_t>(count); c++)
+    {
+      this->block(this->shifts).reset();
+      while (!this->intervals.empty() && this->intervals.front() == this->shifts)
+      {
+        this->pop_front();
+      }
+      this->shifts++;
+    }
+  }
+
+  // Forgets the samples before `oldest`
+  void expire(T oldest)
+  {
+    size_t const width{this->degree + 1};
+    while (!this->intervals.empty() && this->rows[width] < oldest)
+    {
+      size_t const interval{this->intervals.front()};
+      std::copy(this->rows.begin(), this->rows.begin() + width, this->nnz.begin());
+      bool const removed{this->block(interval).remove_row(
+          0, this->nnz.data(), this->rows[width + 1], this->rows[width + 2]
+      )};
+      this->pop_front();
+
+      // The last samples of an interval cannot be downdated without leaving its block singular,
+      // the few left are factorized again
+      if (!removed)
+      {
+        auto &block = this->block(interval);
+        block.reset();
+        for (size_t i{0}; i < this->intervals.size() && this->intervals[i] == interval; i++)
+        {
+          auto const row = this->rows.begin() + i * this->stride();
+          std::copy(row, row + width, this->nnz.begin());
+          block.add_row(0, this->nnz.data(), row[width + 1], row[width + 2]);
+        }
+      }
+    }
+  }
+};
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -0,0 +1,161 @@
+#ifndef DESIGN_MATRIX_HPP
+#define DESIGN_MATRIX_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Core>
+
+// For some reason Eigen has a couple of set but unused variables
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
+#endif
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-but-set-variable"
+#endif
+#include <Eigen/SparseCore>
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::bspline
+{
+
+/**
+ * Compressed storage of the design (collocation) matrix `A(i, j) = B_j(x_i)` of a B-spline, as
+ * built by `BSpline::design_matrix`.
+ *
+ * The arrays follow Eigen's compressed layout, row major (CSR) by default or column major (CSC)
+ * with `Eigen::ColMajor`, so `map()` exposes them as an `Eigen::SparseMatrix` without copying.
+ * Every row holds exactly `degree + 1` entries, columns sorted, periodic columns already wrapped
+ * onto the unpadded control points.
+ */
+template <typename T, int Options = Eigen::RowMajor>
+class DesignMatrix
+{
+public:
+  using SparseMatrix = Eigen::SparseMatrix<T, Options, int>;
+
+private:
+  size_t num_rows{0};
+  size_t num_cols{0};
+  std::vector<int> outer{0};
+  std::vector<int> inner{};
+  std::vector<T> coefficients{};
+
+public:
+  DesignMatrix() = default;
+
+  DesignMatrix(size_t num_rows, size_t num_cols, size_t nnz_per_row)
+      : num_rows{num_rows}, num_cols{num_cols}
+  {
+    size_t nnz = num_rows * nnz_per_row;
+    if (nnz > static_cast<size_t>(std::numeric_limits<int>::max()))
+    {
+      throw std::runtime_error("Design matrix too large for Eigen's default storage index");
+    }
+
+    this->outer.resize((Options == Eigen::RowMajor ? num_rows : num_cols) + 1);
+    this->inner.resize(nnz);
+    this->coefficients.resize(nnz);
+  }
+
+  Eigen::Map<SparseMatrix const> map() const
+  {
+    return {
+        static_cast<Eigen::Index>(this->num_rows),
+        static_cast<Eigen::Index>(this->num_cols),
+        static_cast<Eigen::Index>(this->nnz()),
+        this->outer.data(),
+        this->inner.data(),
+        this->coefficients.data()
+    };
+  }
+
+  Eigen::Map<SparseMatrix> map()
+  {
+    return {
+        static_cast<Eigen::Index>(this->num_rows),
+        static_cast<Eigen::Index>(this->num_cols),
+        static_cast<Eigen::Index>(this->nnz()),
+        this->outer.data(),
+        this->inner.data(),
+        this->coefficients.data()
+    };
+  }
+
+  [[nodiscard]] size_t rows() const { return this->num_rows; }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] size_t nnz() const { return this->coefficients.size(); }
+
+  // Raw compressed arrays, sizes `outer_size() + 1`, `nnz()` and `nnz()`
+  int *outer_index() { return this->outer.data(); }
+  int const *outer_index() const { return this->outer.data(); }
+
+  int *inner_index() { return this->inner.data(); }
+  int const *inner_index() const { return this->inner.data(); }
+
+  T *values() { return this->coefficients.data(); }
+  T const *values() const { return this->coefficients.data(); }
+
+  [[nodiscard]] size_t outer_size() const { return this->outer.size() - 1; }
+};
+
+// Same matrix in column major (CSC) storage, rows stay sorted within each column
+template <typename T>
+DesignMatrix<T, Eigen::ColMajor> to_col_major(DesignMatrix<T, Eigen::RowMajor> const &csr)
+{
+  DesignMatrix<T, Eigen::ColMajor> csc{
+      csr.rows(), csr.cols(), csr.rows() == 0 ? 0 : csr.nnz() / csr.rows()
+  };
+
+  int const *row_outer = csr.outer_index();
+  int const *row_inner = csr.inner_index();
+  T const *row_values  = csr.values();
+  int *col_outer       = csc.outer_index();
+  int *col_inner       = csc.inner_index();
+  T *col_values        = csc.values();
+
+  // Count the entries of every column, then scatter the rows in order
+  std::fill(col_outer, col_outer + csc.outer_size() + 1, 0);
+  for (size_t k{0}; k < csr.nnz(); k++)
+  {
+    col_outer[row_inner[k] + 1]++;
+  }
+  for (size_t j{0}; j < csc.outer_size(); j++)
+  {
+    col_outer[j + 1] += col_outer[j];
+  }
+
+  std::vector<int> next{col_outer, col_outer + csc.outer_size()};
+  for (size_t i{0}; i < csr.rows(); i++)
+  {
+    for (int k{row_outer[i]}; k < row_outer[i + 1]; k++)
+    {
+      int position         = next[row_inner[k]]++;
+      col_inner[position]  = static_cast<int>(i);
+      col_values[position] = row_values[k];
+    }
+  }
+
+  return csc;
+}
+
+} // namespace bsplinex::bspline
+
+#endif
@@ -2,7 +2,13 @@
 #define BSPLINEX_HPP
 
 #include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/bspline/bspline_circulant.hpp"
+#include "BSplineX/bspline/bspline_cursor.hpp"
 #include "BSplineX/bspline/bspline_factory.hpp"
+#include "BSplineX/bspline/bspline_fitter.hpp"
+#include "BSplineX/bspline/bspline_prepared_fit.hpp"
+#include "BSplineX/bspline/bspline_smoothing.hpp"
 #include "BSplineX/bspline/bspline_types.hpp"
+#include "BSplineX/bspline/bspline_window.hpp"
 
 #endif
@@ -1,6 +1,9 @@
 #ifndef C_ATTER_HPP
 #define C_ATTER_HPP
 
+// Standard includes
+#include <vector>
+
 // BSplineX includes
 #include "BSplineX/control_points/c_data.hpp"
 #include "BSplineX/control_points/c_padder.hpp"
@@ -10,32 +13,41 @@
 namespace bsplinex::control_points
 {
 
+// The padded control points are stored in one buffer, so that vectorised kernels can gather them
+// with plain offsets, see `data()`
 template <typename T, BoundaryCondition BC>
 class Atter
 {
 private:
-  Data<T> data;
-  Padder<T, BC> padder;
+  std::vector<T> padded{};
 
 public:
   Atter() = default;
 
-  Atter(Data<T> data, size_t degree) : data{data}, padder{this->data, degree} {}
-
-  T at(size_t index) const
+  Atter(Data<T> data, size_t degree)
   {
-    assertm(index < this->size(), "Out of bounds");
-    if (index < this->data.size())
+    Padder<T, BC> padder{data, degree};
+
+    this->padded.reserve(data.size() + padder.size());
+    for (size_t i{0}; i < data.size(); i++)
     {
-      return this->data.at(index);
+      this->padded.push_back(data.at(i));
     }
-    else
+    for (size_t i{0}; i < padder.size(); i++)
     {
-      return this->padder.right(index - this->data.size());
+      this->padded.push_back(padder.right(i));
     }
   }
 
-  [[nodiscard]] size_t size() const { return this->data.size() + this->padder.size(); }
+  T at(size_t index) const
+  {
+    assertm(index < this->size(), "Out of bounds");
+    return this->padded[index];
+  }
+
+  [[nodiscard]] T const *data() const { return this->padded.data(); }
+
+  [[nodiscard]] size_t size() const { return this->padded.size(); }
 };
 
 } // namespace bsplinex::control_points
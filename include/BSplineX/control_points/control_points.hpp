@@ -42,6 +42,8 @@ public:
 
   T at(size_t index) const { return this->atter.at(index); }
 
+  [[nodiscard]] T const *data() const { return this->atter.data(); }
+
   [[nodiscard]] size_t size() const { return this->atter.size(); }
 
   void set_data(std::vector<T> const &data) { this->atter = Atter<T, BC>{{data}, this->degree}; }
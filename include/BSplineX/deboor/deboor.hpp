@@ -0,0 +1,355 @@
+#ifndef DEBOOR_HPP
+#define DEBOOR_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+constexpr size_t EVALUATE_BATCH_SIZE = 128;
+constexpr size_t STACK_MAX_DEGREE    = 15;
+constexpr size_t DYNAMIC_DEGREE      = std::numeric_limits<size_t>::max();
+
+/**
+ * De Boor and basis kernels.
+ *
+ * The kernels are written once against a `Degree` type that is either a plain `size_t` (degree
+ * known at runtime) or a `std::integral_constant` (degree known at compile time). In the latter
+ * case every loop has a constant trip count and the compiler can fully unroll it, keeping the
+ * support on the stack.
+ *
+ * `DeBoor<T, P>` binds a kernel to a compile-time degree, `DeBoor<T>` to a runtime one, and
+ * `dispatch` selects the fixed-degree kernel for the common degrees.
+ *
+ * Knots are read through a raw pointer to the contiguous padded buffer materialised by
+ * `knots::Atter`, see `knots::Knots::data()`.
+ */
+
+namespace bsplinex::deboor
+{
+
+template <typename T, typename Degree, typename ControlPoints>
+T deboor(
+    Degree degree,
+    T *support,
+    T const *knots,
+    ControlPoints const &control_points,
+    size_t index,
+    T value
+)
+{
+  for (size_t j = 0; j <= degree; j++)
+  {
+    support[j] = control_points.at(j + index - degree);
+  }
+
+  for (size_t r = 1; r <= degree; r++)
+  {
+    for (size_t j = degree; j >= r; j--)
+    {
+      T left     = knots[j + index - degree];
+      T alpha    = (value - left) / (knots[j + 1 + index - r] - left);
+      support[j] = ((T)1 - alpha) * support[j - 1] + alpha * support[j];
+    }
+  }
+
+  return support[degree];
+}
+
+// `support` holds `degree + 1` rows of `EVALUATE_BATCH_SIZE` lanes so that the innermost loops run
+// over independent points
+template <typename T, typename Degree, typename ControlPoints>
+void deboor(
+    Degree degree,
+    T *support,
+    T const *knots,
+    ControlPoints const &control_points,
+    size_t const *indices,
+    T const *values,
+    size_t count,
+    T *results
+)
+{
+  assertm(count <= EVALUATE_BATCH_SIZE, "Batch too large");
+
+  for (size_t j = 0; j <= degree; j++)
+  {
+    T *row = support + j * EVALUATE_BATCH_SIZE;
+    for (size_t l = 0; l < count; l++)
+    {
+      row[l] = control_points.at(j + indices[l] - degree);
+    }
+  }
+
+  for (size_t r = 1; r <= degree; r++)
+  {
+    for (size_t j = degree; j >= r; j--)
+    {
+      T *row            = support + j * EVALUATE_BATCH_SIZE;
+      T const *row_prev = support + (j - 1) * EVALUATE_BATCH_SIZE;
+      for (size_t l = 0; l < count; l++)
+      {
+        T left  = knots[j + indices[l] - degree];
+        T right = knots[j + 1 + indices[l] - r];
+        T alpha = (values[l] - left) / (right - left);
+        row[l]  = ((T)1 - alpha) * row_prev[l] + alpha * row[l];
+      }
+    }
+  }
+
+  std::copy_n(support + degree * EVALUATE_BATCH_SIZE, count, results);
+}
+
+// Writes the `degree + 1` non-zero basis functions at `value` in `[end - degree - 1, end[`
+template <typename T, typename Degree, typename It>
+void basis(Degree degree, T const *knots, size_t index, T value, It end)
+{
+  *(end - 1) = 1.0;
+  for (size_t d{1}; d <= degree; d++)
+  {
+    *(end - 1 - d) = (knots[index + 1] - value) /
+                     (knots[index + 1] - knots[index - d + 1]) * *(end - 1 - d + 1);
+    for (size_t i{index - d + 1}; i < index; i++)
+    {
+      *(end - 1 - index + i) =
+          (value - knots[i]) / (knots[i + d] - knots[i]) * *(end - 1 - index + i) +
+          (knots[i + d + 1] - value) / (knots[i + d + 1] - knots[i + 1]) *
+              *(end - 1 - index + i + 1);
+    }
+    *(end - 1) = (value - knots[index]) / (knots[index + d] - knots[index]) * *(end - 1);
+  }
+}
+
+/**
+ * The `degree + 1` non-zero basis functions on `[knots[index], knots[index + 1][` as polynomials in
+ * `u = (value - knots[index]) / (knots[index + 1] - knots[index])`, i.e. the recurrence of `basis`
+ * run on polynomials instead of numbers. The coefficient of `u^m` of the function `basis` writes
+ * at `end - degree - 1 + j` is stored at `coeffs[m * (degree + 1) + j]`.
+ *
+ * Every span the recurrence divides by contains the interval, so the coefficients stay bounded
+ * and `basis_at` evaluates them for `u` in `[0, 1]` as accurately as `basis` does, without
+ * divisions.
+ */
+template <typename T, typename Degree>
+void basis_polynomials(Degree degree, T const *knots, size_t index, T *coeffs)
+{
+  size_t const n{degree + 1};
+  T const left{knots[index]};
+  T const width{knots[index + 1] - left};
+  auto at = [&](size_t m, size_t j) -> T & { return coeffs[m * n + j]; };
+
+  std::fill_n(coeffs, n * n, (T)0);
+  at(0, degree) = 1.0;
+  for (size_t d{1}; d <= degree; d++)
+  {
+    // Products by `a + b u` run from the highest power down, reading the lower one before it is
+    // overwritten
+    T span{knots[index + 1] - knots[index - d + 1]};
+    T a{(knots[index + 1] - left) / span};
+    T b{width / span};
+    for (size_t m{d}; m > 0; m--)
+    {
+      at(m, degree - d) = a * at(m, degree - d + 1) - b * at(m - 1, degree - d + 1);
+    }
+    at(0, degree - d) = a * at(0, degree - d + 1);
+
+    for (size_t i{index - d + 1}; i < index; i++)
+    {
+      size_t const j{degree - index + i};
+      T const span_left{knots[i + d] - knots[i]};
+      T const a_left{(left - knots[i]) / span_left};
+      T const b_left{width / span_left};
+      T const span_right{knots[i + d + 1] - knots[i + 1]};
+      T const a_right{(knots[i + d + 1] - left) / span_right};
+      T const b_right{width / span_right};
+      for (size_t m{d}; m > 0; m--)
+      {
+        at(m, j) = a_left * at(m, j) + b_left * at(m - 1, j) + a_right * at(m, j + 1) -
+                   b_right * at(m - 1, j + 1);
+      }
+      at(0, j) = a_left * at(0, j) + a_right * at(0, j + 1);
+    }
+
+    b = width / (knots[index + d] - left);
+    for (size_t m{d}; m > 0; m--)
+    {
+      at(m, degree) = b * at(m - 1, degree);
+    }
+    at(0, degree) = 0.0;
+  }
+}
+
+// Evaluates the polynomials of `basis_polynomials` at `u` by Horner's rule, writing the `degree +
+// 1` basis functions to `[end - degree - 1, end[`
+template <typename T, typename Degree, typename It>
+void basis_at(Degree degree, T const *coeffs, T u, It end)
+{
+  size_t const n{degree + 1};
+  It first = end - n;
+  for (size_t j{0}; j < n; j++)
+  {
+    *(first + j) = coeffs[degree * n + j];
+  }
+  for (size_t m{degree}; m > 0; m--)
+  {
+    for (size_t j{0}; j < n; j++)
+    {
+      *(first + j) = *(first + j) * u + coeffs[(m - 1) * n + j];
+    }
+  }
+}
+
+template <typename T, size_t P = DYNAMIC_DEGREE>
+class DeBoor
+{
+private:
+  std::integral_constant<size_t, P> degree{};
+
+public:
+  DeBoor() = default;
+
+  DeBoor([[maybe_unused]] size_t degree) { assertm(degree == P, "Wrong compile-time degree"); }
+
+  [[nodiscard]] size_t get_degree() const { return P; }
+
+  // The degree as the kernels see it, here a compile-time constant
+  [[nodiscard]] std::integral_constant<size_t, P> get_static_degree() const { return this->degree; }
+
+  template <typename ControlPoints>
+  T evaluate(T const *knots, ControlPoints const &control_points, size_t index, T value) const
+  {
+    T support[P + 1];
+    return deboor::deboor(this->degree, support, knots, control_points, index, value);
+  }
+
+  template <typename ControlPoints>
+  void evaluate(
+      T const *knots,
+      ControlPoints const &control_points,
+      size_t const *indices,
+      T const *values,
+      size_t count,
+      T *results
+  ) const
+  {
+    T support[(P + 1) * EVALUATE_BATCH_SIZE];
+    deboor::deboor(
+        this->degree, support, knots, control_points, indices, values, count, results
+    );
+  }
+
+  template <typename It>
+  void basis(T const *knots, size_t index, T value, It end) const
+  {
+    deboor::basis(this->degree, knots, index, value, end);
+  }
+};
+
+template <typename T>
+class DeBoor<T, DYNAMIC_DEGREE>
+{
+private:
+  size_t degree{0};
+  std::vector<T> batch_support{};
+
+public:
+  DeBoor() = default;
+
+  DeBoor(size_t degree) : degree{degree} {}
+
+  [[nodiscard]] size_t get_degree() const { return this->degree; }
+
+  [[nodiscard]] size_t get_static_degree() const { return this->degree; }
+
+  template <typename ControlPoints>
+  T evaluate(T const *knots, ControlPoints const &control_points, size_t index, T value) const
+  {
+    // Low degrees use stack scratch, so evaluation never touches shared state
+    T stack_support[STACK_MAX_DEGREE + 1];
+    std::vector<T> heap_support{};
+    T *support = stack_support;
+    if (this->degree > STACK_MAX_DEGREE)
+    {
+      heap_support.resize(this->degree + 1);
+      support = heap_support.data();
+    }
+
+    return deboor::deboor(this->degree, support, knots, control_points, index, value);
+  }
+
+  template <typename ControlPoints>
+  void evaluate(
+      T const *knots,
+      ControlPoints const &control_points,
+      size_t const *indices,
+      T const *values,
+      size_t count,
+      T *results
+  )
+  {
+    this->batch_support.resize((this->degree + 1) * EVALUATE_BATCH_SIZE);
+    deboor::deboor(
+        this->degree,
+        this->batch_support.data(),
+        knots,
+        control_points,
+        indices,
+        values,
+        count,
+        results
+    );
+  }
+
+  template <typename It>
+  void basis(T const *knots, size_t index, T value, It end) const
+  {
+    deboor::basis(this->degree, knots, index, value, end);
+  }
+};
+
+/**
+ * Calls `kernel` with a `DeBoor` bound to `degree`, using the compile-time specialisations for the
+ * common degrees and the runtime one otherwise. Dispatch once outside hot loops so that the loop
+ * body is instantiated for the fixed degree.
+ */
+template <typename T, typename F>
+decltype(auto) dispatch(size_t degree, F &&kernel)
+{
+  switch (degree)
+  {
+  case 1:
+  {
+    DeBoor<T, 1> fixed{};
+    return kernel(fixed);
+  }
+  case 2:
+  {
+    DeBoor<T, 2> fixed{};
+    return kernel(fixed);
+  }
+  case 3:
+  {
+    DeBoor<T, 3> fixed{};
+    return kernel(fixed);
+  }
+  case 5:
+  {
+    DeBoor<T, 5> fixed{};
+    return kernel(fixed);
+  }
+  default:
+  {
+    DeBoor<T> dynamic{degree};
+    return kernel(dynamic);
+  }
+  }
+}
+
+} // namespace bsplinex::deboor
+
+#endif
@@ -0,0 +1,134 @@
+#ifndef MAPPED_FILE_HPP
+#define MAPPED_FILE_HPP
+
+// Standard includes
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#define BSPLINEX_HAS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::io
+{
+
+/**
+ * Read-only view of a whole file. On POSIX systems the file is memory mapped, so files larger than
+ * the available memory can be streamed through: the kernel pages the data in as it is read and
+ * drops it again under memory pressure. Elsewhere the file is read into memory.
+ */
+class MappedFile
+{
+private:
+  char const *bytes{nullptr};
+  size_t num_bytes{0};
+#ifndef BSPLINEX_HAS_MMAP
+  std::vector<char> buffer{};
+#endif
+
+public:
+  MappedFile() = default;
+
+  explicit MappedFile(std::string const &path)
+  {
+#ifdef BSPLINEX_HAS_MMAP
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error("Could not open " + path);
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) != 0)
+    {
+      ::close(fd);
+      throw std::runtime_error("Could not stat " + path);
+    }
+    this->num_bytes = static_cast<size_t>(info.st_size);
+
+    if (this->num_bytes > 0)
+    {
+      void *address = ::mmap(nullptr, this->num_bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (address == MAP_FAILED)
+      {
+        ::close(fd);
+        throw std::runtime_error("Could not map " + path);
+      }
+      ::madvise(address, this->num_bytes, MADV_SEQUENTIAL);
+      this->bytes = static_cast<char const *>(address);
+    }
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+#else
+    std::ifstream file{path, std::ios::binary | std::ios::ate};
+    if (!file)
+    {
+      throw std::runtime_error("Could not open " + path);
+    }
+    this->buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    file.read(this->buffer.data(), static_cast<std::streamsize>(this->buffer.size()));
+    if (!file)
+    {
+      throw std::runtime_error("Could not read " + path);
+    }
+    this->bytes     = this->buffer.data();
+    this->num_bytes = this->buffer.size();
+#endif
+  }
+
+  MappedFile(MappedFile const &other) = delete;
+
+  MappedFile(MappedFile &&other) noexcept { *this = std::move(other); }
+
+  ~MappedFile() noexcept { this->unmap(); }
+
+  MappedFile &operator=(MappedFile const &other) = delete;
+
+  MappedFile &operator=(MappedFile &&other) noexcept
+  {
+    if (this == &other)
+      return *this;
+    this->unmap();
+#ifndef BSPLINEX_HAS_MMAP
+    this->buffer = std::move(other.buffer);
+#endif
+    this->bytes     = other.bytes;
+    this->num_bytes = other.num_bytes;
+    other.bytes     = nullptr;
+    other.num_bytes = 0;
+    return *this;
+  }
+
+  [[nodiscard]] char const *data() const { return this->bytes; }
+
+  [[nodiscard]] size_t size() const { return this->num_bytes; }
+
+private:
+  void unmap() noexcept
+  {
+#ifdef BSPLINEX_HAS_MMAP
+    if (this->bytes != nullptr)
+    {
+      ::munmap(const_cast<char *>(this->bytes), this->num_bytes);
+    }
+#endif
+    this->bytes     = nullptr;
+    this->num_bytes = 0;
+  }
+};
+
+} // namespace bsplinex::io
+
+#endif
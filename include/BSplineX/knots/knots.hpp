@@ -51,8 +51,9 @@ private:
 public:
   Knots() { DEBUG_LOG_CALL(); }
 
-  Knots(Data<T, C> const &data, size_t degree)
-      : atter{data, degree}, extrapolator{this->atter, degree}, finder{this->atter, degree},
+  Knots(Data<T, C> const &data, size_t degree, Search search = Search::AUTO)
+      : atter{data, degree}, extrapolator{this->atter, degree},
+        finder{this->atter, degree, search},
         value_left{this->atter.at(degree)},
         value_right{this->atter.at(this->atter.size() - degree - 1)}, degree{degree}
   {
@@ -60,7 +61,10 @@ public:
   }
 
   Knots(Knots const &other)
-      : atter(other.atter), extrapolator(other.extrapolator), finder(this->atter, other.degree),
+      : atter(other.atter), extrapolator(other.extrapolator),
+        finder(
+            this->atter, other.degree, other.finder.get_search(), other.finder.get_num_buckets()
+        ),
         value_left(other.value_left), value_right(other.value_right), degree{other.degree}
   {
     DEBUG_LOG_CALL();
@@ -68,10 +72,11 @@ public:
 
   Knots(Knots &&other) noexcept
       : atter(std::move(other.atter)), extrapolator(std::move(other.extrapolator)),
-        finder(this->atter, other.degree), value_left(std::move(other.value_left)),
+        finder(std::move(other.finder)), value_left(std::move(other.value_left)),
         value_right(std::move(other.value_right)), degree{other.degree}
   {
     DEBUG_LOG_CALL();
+    this->finder.rebind(this->atter);
   }
 
   ~Knots() { DEBUG_LOG_CALL(); }
@@ -81,13 +86,9 @@ public:
     DEBUG_LOG_CALL();
     if (this == &other)
       return *this;
-    this->atter        = other.atter;
-    this->extrapolator = other.extrapolator;
-    new (&this->finder) Finder<T, C, BC, EXT>(this->atter, other.degree);
-    this->value_left  = other.value_left;
-    this->value_right = other.value_right;
-    this->degree      = other.degree;
-    return *this;
+    // Copied aside first, so that a failed allocation leaves these knots as they were
+    Knots copy{other};
+    return *this = std::move(copy);
   }
 
   Knots &operator=(Knots &&other) noexcept
@@ -97,7 +98,8 @@ public:
       return *this;
     this->atter        = std::move(other.atter);
     this->extrapolator = std::move(other.extrapolator);
-    new (&this->finder) Finder<T, C, BC, EXT>(this->atter, other.degree);
+    this->finder       = std::move(other.finder);
+    this->finder.rebind(this->atter);
     this->value_left  = std::move(other.value_left);
     this->value_right = std::move(other.value_right);
     this->degree      = other.degree;
@@ -114,10 +116,34 @@ public:
     return std::pair<size_t, T>{this->finder.find(value), value};
   }
 
-  std::pair<T, T> domain() { return {value_left, value_right}; }
+  // Like `find`, but starting the search from the interval `hint`, see `Finder::find_ordered`
+  std::pair<size_t, T> find_ordered(T value, size_t hint) const
+  {
+    if (value < this->value_left || value >= this->value_right)
+    {
+      value = this->extrapolator.extrapolate(value);
+    }
+
+    return std::pair<size_t, T>{this->finder.find_ordered(value, hint), value};
+  }
+
+  std::pair<T, T> domain() const { return {value_left, value_right}; }
+
+  void set_search(Search search, size_t num_buckets = 0)
+  {
+    this->finder.set_search(search, num_buckets);
+  }
+
+  [[nodiscard]] Search get_search() const { return this->finder.get_search(); }
+
+  [[nodiscard]] size_t get_num_buckets() const { return this->finder.get_num_buckets(); }
+
+  [[nodiscard]] size_t search_memory() const { return this->finder.search_memory(); }
 
   T at(size_t index) const { return this->atter.at(index); }
 
+  T const *data() const { return this->atter.data(); }
+
   [[nodiscard]] size_t size() const { return this->atter.size(); }
 };
 
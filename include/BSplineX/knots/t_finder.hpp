@@ -4,10 +4,12 @@
 // Standard includes
 #include <algorithm>
 #include <cstddef>
+#include <utility>
 
 // BSplineX includes
 #include "BSplineX/defines.hpp"
 #include "BSplineX/knots/t_atter.hpp"
+#include "BSplineX/knots/t_search.hpp"
 #include "BSplineX/types.hpp"
 
 namespace bsplinex::knots
@@ -20,25 +22,60 @@ private:
   Atter<T, C, BC> const *atter{nullptr};
   size_t index_left{0};
   size_t index_right{0};
+  Search search{Search::BINARY};
+  Eytzinger<T> eytzinger{};
+  Bucket<T> bucket{};
 
 public:
   Finder() { DEBUG_LOG_CALL(); }
 
-  Finder(Atter<T, C, BC> const &atter, size_t degree)
+  Finder(
+      Atter<T, C, BC> const &atter,
+      size_t degree,
+      Search search      = Search::AUTO,
+      size_t num_buckets = 0
+  )
       : atter{&atter}, index_left{degree}, index_right{this->atter->size() - degree - 1}
   {
     DEBUG_LOG_CALL();
+    this->set_search(search, num_buckets);
   }
 
   Finder(Finder const &other) = delete;
 
-  Finder(Finder &&other) = delete;
+  // The search layouts are moved as they are, call `rebind` once the knots have moved too
+  Finder(Finder &&other) noexcept
+      : atter{other.atter}, index_left{other.index_left}, index_right{other.index_right},
+        search{other.search}, eytzinger{std::move(other.eytzinger)},
+        bucket{std::move(other.bucket)}
+  {
+    DEBUG_LOG_CALL();
+  }
 
   ~Finder() noexcept { DEBUG_LOG_CALL(); }
 
   Finder &operator=(Finder const &other) = delete;
 
-  Finder &operator=(Finder &&other) = delete;
+  Finder &operator=(Finder &&other) noexcept
+  {
+    DEBUG_LOG_CALL();
+    if (this == &other)
+      return *this;
+    this->atter       = other.atter;
+    this->index_left  = other.index_left;
+    this->index_right = other.index_right;
+    this->search      = other.search;
+    this->eytzinger   = std::move(other.eytzinger);
+    this->bucket      = std::move(other.bucket);
+    return *this;
+  }
+
+  // Points the finder at `atter`, holding the knots it was built on, e.g. after both were moved
+  void rebind(Atter<T, C, BC> const &atter)
+  {
+    this->atter = &atter;
+    this->bucket.rebind(this->atter->data() + this->index_left);
+  }
 
   size_t find(T value) const
   {
@@ -49,11 +86,102 @@ public:
         "Value outside of the domain"
     );
 
-    auto upper = std::upper_bound(
-        this->atter->begin() + this->index_left, this->atter->begin() + this->index_right, value
+    T const *knots = this->atter->data() + this->index_left;
+    size_t size    = this->index_right - this->index_left;
+    size_t upper{0};
+
+    switch (this->search)
+    {
+    case Search::LINEAR:
+      upper = upper_bound_linear(knots, size, value);
+      break;
+    case Search::BRANCHLESS:
+      upper = upper_bound_branchless(knots, size, value);
+      break;
+    case Search::EYTZINGER:
+      upper = this->eytzinger.upper_bound(value);
+      break;
+    case Search::BUCKET:
+      // The index also holds the right end of the domain, which belongs to the last interval
+      upper = std::min(this->bucket.upper_bound(value), size);
+      break;
+    default:
+      upper = std::upper_bound(knots, knots + size, value) - knots;
+      break;
+    }
+
+    return this->index_left + upper - 1;
+  }
+
+  // `Search::AUTO` is resolved here, `get_search` returns the policy actually in use.
+  // `num_buckets` only matters for `Search::BUCKET`, 0 means one bucket per knot interval
+  void set_search(Search search, size_t num_buckets = 0)
+  {
+    size_t size  = this->index_right - this->index_left;
+    this->search = search == Search::AUTO ? choose_search(size) : search;
+
+    this->eytzinger = this->search == Search::EYTZINGER
+                          ? Eytzinger<T>{this->atter->data() + this->index_left, size}
+                          : Eytzinger<T>{};
+
+    // The bucket index covers the domain, i.e. the knots from `index_left` to `index_right`
+    this->bucket = this->search == Search::BUCKET
+                       ? Bucket<T>{
+                             this->atter->data() + this->index_left,
+                             size + 1,
+                             num_buckets == 0 ? size : num_buckets
+                         }
+                       : Bucket<T>{};
+  }
+
+  [[nodiscard]] Search get_search() const { return this->search; }
+
+  [[nodiscard]] size_t get_num_buckets() const { return this->bucket.num_buckets(); }
+
+  // Bytes of auxiliary storage used by the search policy on top of the knots
+  [[nodiscard]] size_t search_memory() const
+  {
+    return this->eytzinger.memory() + this->bucket.memory();
+  }
+
+  // Same result as `find`, but the search starts from the interval `hint` (typically the previous
+  // result) and gallops outwards from it, so sorted sequences cost amortised O(1) per value while
+  // unrelated values are still found in O(log m)
+  size_t find_ordered(T value, size_t hint) const
+  {
+    assertm(
+        value >= this->atter->at(this->index_left) && value <= this->atter->at(this->index_right),
+        "Value outside of the domain"
     );
 
-    return upper - this->atter->begin() - 1;
+    T const *knots = this->atter->data();
+    size_t lo{std::clamp(hint, this->index_left, this->index_right - 1)};
+    size_t hi{lo + 1};
+    size_t step{1};
+
+    // Bracket the value so that knots[lo] <= value and (hi == index_right or knots[hi] > value)
+    if (knots[lo] <= value)
+    {
+      while (hi < this->index_right && knots[hi] <= value)
+      {
+        lo    = hi;
+        hi    = std::min(hi + step, this->index_right);
+        step *= 2;
+      }
+    }
+    else
+    {
+      do
+      {
+        hi    = lo;
+        lo   -= std::min(step, lo - this->index_left);
+        step *= 2;
+      } while (lo > this->index_left && knots[lo] > value);
+    }
+
+    T const *upper = std::upper_bound(knots + lo + 1, knots + hi, value);
+
+    return upper - knots - 1;
   }
 };
 
@@ -65,31 +193,57 @@ private:
   T value_right{};
   T step_size_inv{};
   size_t degree{};
+  size_t index_last{};
 
 public:
   Finder() { DEBUG_LOG_CALL(); }
 
-  Finder(Atter<T, Curve::UNIFORM, BC> const &atter, size_t degree)
+  Finder(
+      Atter<T, Curve::UNIFORM, BC> const &atter,
+      size_t degree,
+      Search = Search::AUTO,
+      size_t = 0
+  )
       : value_left{atter.at(degree)}, value_right{atter.at(atter.size() - degree - 1)},
-        step_size_inv{T(1) / (atter.at(degree + 1) - atter.at(degree))}, degree{degree}
+        step_size_inv{T(1) / (atter.at(degree + 1) - atter.at(degree))}, degree{degree},
+        index_last{atter.size() - degree - 2}
   {
     DEBUG_LOG_CALL();
   }
 
   Finder(Finder const &other) = delete;
 
-  Finder(Finder &&other) = delete;
+  Finder(Finder &&other) noexcept = default;
 
   Finder &operator=(Finder const &other) = delete;
 
-  Finder &operator=(Finder &&other) = delete;
+  Finder &operator=(Finder &&other) noexcept = default;
+
+  // Nothing points to the knots
+  void rebind(Atter<T, Curve::UNIFORM, BC> const &) {}
 
   size_t find(T value) const
   {
     assertm(value >= this->value_left && value <= this->value_right, "Value outside of the domain");
 
-    return static_cast<size_t>((value - this->value_left) * this->step_size_inv) + this->degree;
+    // The right end of the domain (and round-off just below it) belongs to the last interval, as
+    // with `std::upper_bound` in the non-uniform case
+    return std::min(
+        static_cast<size_t>((value - this->value_left) * this->step_size_inv) + this->degree,
+        this->index_last
+    );
   }
+
+  size_t find_ordered(T value, size_t) const { return this->find(value); }
+
+  // The uniform finder is already O(1), search policies do not apply
+  void set_search(Search, size_t = 0) {}
+
+  [[nodiscard]] Search get_search() const { return Search::AUTO; }
+
+  [[nodiscard]] size_t get_num_buckets() const { return 0; }
+
+  [[nodiscard]] size_t search_memory() const { return 0; }
 };
 
 } // namespace bsplinex::knots
@@ -0,0 +1,229 @@
+#ifndef T_SEARCH_HPP
+#define T_SEARCH_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+#include "BSplineX/types.hpp"
+
+/**
+ * Search policies used by the non-uniform `Finder`. Every policy returns the same thing as
+ * `std::upper_bound(first, first + n, value) - first`, i.e. the number of knots `<= value`.
+ *
+ * - `Search::BINARY`: `std::upper_bound`, branchy
+ * - `Search::BRANCHLESS`: binary search with conditional moves instead of branches, no
+ *   mispredictions at the price of always doing `log2(n)` steps
+ * - `Search::EYTZINGER`: binary search on a breadth-first (Eytzinger) copy of the knots, so the
+ *   first levels of the implicit tree share cache lines, good for knot vectors that do not fit in
+ *   cache
+ * - `Search::LINEAR`: counts the knots `<= value` with a loop the compiler vectorises, best for
+ *   short knot vectors
+ * - `Search::BUCKET`: splits the domain in equal buckets and stores the knots range each of them
+ *   overlaps, so that a lookup is a multiply plus a search over a handful of knots. O(1) for
+ *   mildly irregular knots, the bucket count trades memory for speed
+ * - `Search::AUTO`: picks one of the above from the number of knots
+ *
+ * The thresholds below come from the knot search benchmarks: the Eytzinger layout only beats the
+ * branchless search once the knots no longer fit in the last level cache (about 8 MB of doubles).
+ */
+
+constexpr size_t LINEAR_SEARCH_MAX    = 16;
+constexpr size_t EYTZINGER_SEARCH_MIN = 1 << 20;
+constexpr size_t BUCKET_SEARCH_LINEAR = 8;
+
+namespace bsplinex::knots
+{
+
+inline Search choose_search(size_t size)
+{
+  if (size <= LINEAR_SEARCH_MAX)
+  {
+    return Search::LINEAR;
+  }
+  if (size < EYTZINGER_SEARCH_MIN)
+  {
+    return Search::BRANCHLESS;
+  }
+  return Search::EYTZINGER;
+}
+
+template <typename T>
+size_t upper_bound_linear(T const *first, size_t n, T value)
+{
+  size_t count{0};
+  for (size_t i{0}; i < n; i++)
+  {
+    count += static_cast<size_t>(first[i] <= value);
+  }
+  return count;
+}
+
+template <typename T>
+size_t upper_bound_branchless(T const *first, size_t n, T value)
+{
+  if (n == 0)
+  {
+    return 0;
+  }
+
+  T const *base = first;
+  while (n > 1)
+  {
+    size_t half  = n / 2;
+    base        += (base[half] <= value) ? half : 0;
+    n           -= half;
+  }
+
+  return static_cast<size_t>(base - first) + static_cast<size_t>(*base <= value);
+}
+
+template <typename T>
+class Eytzinger
+{
+private:
+  // 1-based breadth-first layout, `rank[k]` is the sorted position of `layout[k]` and `rank[0]`
+  // is the size, returned when no element is greater than the value
+  std::vector<T> layout{};
+  std::vector<size_t> rank{};
+
+public:
+  Eytzinger() = default;
+
+  Eytzinger(T const *first, size_t n) : layout(n + 1), rank(n + 1)
+  {
+    size_t i{0};
+    this->build(first, i, 1);
+    this->rank[0] = n;
+  }
+
+  size_t upper_bound(T value) const
+  {
+    size_t const n = this->layout.size() - 1;
+    size_t k{1};
+    while (k <= n)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      // The descendants four levels down share a cache line, fetch them while we compare
+      __builtin_prefetch(this->layout.data() + std::min(16 * k, n));
+#endif
+      k = 2 * k + static_cast<size_t>(this->layout[k] <= value);
+    }
+
+    // Undo the trailing right turns and the last left one to find the first greater element
+#if defined(__GNUC__) || defined(__clang__)
+    k >>= __builtin_ctzll(~static_cast<unsigned long long>(k)) + 1;
+#else
+    while (k & 1)
+    {
+      k >>= 1;
+    }
+    k >>= 1;
+#endif
+
+    return this->rank[k];
+  }
+
+  [[nodiscard]] size_t size() const { return this->layout.empty() ? 0 : this->layout.size() - 1; }
+
+  [[nodiscard]] size_t memory() const
+  {
+    return this->layout.capacity() * sizeof(T) + this->rank.capacity() * sizeof(size_t);
+  }
+
+private:
+  void build(T const *first, size_t &i, size_t k)
+  {
+    if (k >= this->layout.size())
+    {
+      return;
+    }
+    this->build(first, i, 2 * k);
+    this->layout[k] = first[i];
+    this->rank[k]   = i++;
+    this->build(first, i, 2 * k + 1);
+  }
+};
+
+template <typename T>
+class Bucket
+{
+private:
+  T const *first{nullptr};
+  size_t n{0};
+  T value_left{};
+  T bucket_size_inv{};
+  // `bounds[b]` is the number of knots `<= value_left + b * bucket_size`, the answer for any value
+  // in bucket `b` lies in `[bounds[b], bounds[b + 1]]`
+  std::vector<size_t> bounds{};
+
+public:
+  Bucket() = default;
+
+  Bucket(T const *first, size_t n, size_t num_buckets) : first{first}, n{n}
+  {
+    assertm(n > 1 && num_buckets > 0, "Bucket index needs at least one interval and one bucket");
+
+    this->value_left      = first[0];
+    T bucket_size         = (first[n - 1] - first[0]) / (T)num_buckets;
+    this->bucket_size_inv = (T)1 / bucket_size;
+
+    this->bounds.resize(num_buckets + 1);
+    size_t count{0};
+    for (size_t b{0}; b < num_buckets; b++)
+    {
+      T edge = this->value_left + (T)b * bucket_size;
+      while (count < n && first[count] <= edge)
+      {
+        count++;
+      }
+      this->bounds[b] = count;
+    }
+    this->bounds[num_buckets] = n;
+  }
+
+  size_t upper_bound(T value) const
+  {
+    T scaled = (value - this->value_left) * this->bucket_size_inv;
+    size_t b = scaled > (T)0 ? std::min(static_cast<size_t>(scaled), this->num_buckets() - 1) : 0;
+
+    // Round-off in the bucket computation can land one bucket off, widen the range if so
+    size_t b_lo{b};
+    size_t b_hi{b + 1};
+    while (b_lo > 0 && this->first[this->bounds[b_lo] - 1] > value)
+    {
+      b_lo--;
+    }
+    while (b_hi < this->num_buckets() && this->bounds[b_hi] < this->n &&
+           this->first[this->bounds[b_hi]] <= value)
+    {
+      b_hi++;
+    }
+
+    size_t lo{this->bounds[b_lo]};
+    size_t hi{this->bounds[b_hi]};
+
+    if (hi - lo <= BUCKET_SEARCH_LINEAR)
+    {
+      return lo + upper_bound_linear(this->first + lo, hi - lo, value);
+    }
+    return lo + upper_bound_branchless(this->first + lo, hi - lo, value);
+  }
+
+  [[nodiscard]] size_t num_buckets() const
+  {
+    return this->bounds.empty() ? 0 : this->bounds.size() - 1;
+  }
+
+  // Points the index at `first`, a copy of the knots it was built on, e.g. after they moved
+  void rebind(T const *first) { this->first = first; }
+
+  [[nodiscard]] size_t memory() const { return this->bounds.capacity() * sizeof(size_t); }
+};
+
+} // namespace bsplinex::knots
+
+#endif
@@ -0,0 +1,295 @@
+#ifndef BANDED_CHOLESKY_HPP
+#define BANDED_CHOLESKY_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Symmetric positive definite matrix with `width - 1` non-zero diagonals above (and below) the
+ * main one, and its Cholesky factorization `A = U^T U`.
+ *
+ * Only the upper band is stored, `A(k, k + j)` at `[k * width + j]`, and `U` overwrites it with the
+ * same layout since it has the same band. This is the shape of the normal equations `B^T B` of a
+ * B-spline of degree `p`, `width = p + 1`, so they can be accumulated one sample at a time with
+ * `add_outer` and solved in `O(n * p^2)` without ever forming the design matrix `B`.
+ */
+template <typename T>
+class BandedCholesky
+{
+private:
+  size_t num_cols{0};
+  size_t width{0};
+  std::vector<T> band{};
+  bool factorized{false};
+
+public:
+  BandedCholesky() = default;
+
+  BandedCholesky(size_t num_cols, size_t width)
+      : num_cols{num_cols}, width{width}, band(num_cols * width, (T)0)
+  {
+    assertm(width > 0, "The band must hold at least the diagonal");
+  }
+
+  // Upper band entry `A(i, j)`, `i <= j < i + width`
+  T &at(size_t i, size_t j)
+  {
+    assertm(i <= j && j < i + this->width && j < this->num_cols, "Outside of the upper band");
+    return this->band[i * this->width + j - i];
+  }
+
+  T at(size_t i, size_t j) const
+  {
+    assertm(i <= j && j < i + this->width && j < this->num_cols, "Outside of the upper band");
+    return this->band[i * this->width + j - i];
+  }
+
+  /**
+   * `A += weight * a a^T` where `a` is zero but for `a[first + j] = coeffs[j]`, `j < width`. That
+   * is the contribution of one row of the design matrix to the normal equations.
+   */
+  void add_outer(size_t first, T const *coeffs, T weight = (T)1)
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+    assertm(first + this->width <= this->num_cols, "Row past the last column");
+
+    T *a = this->band.data() + first * this->width;
+    for (size_t i{0}; i < this->width; i++)
+    {
+      T const scaled{weight * coeffs[i]};
+      for (size_t j{i}; j < this->width; j++)
+      {
+        a[j - i] += scaled * coeffs[j];
+      }
+      a += this->width;
+    }
+  }
+
+  /**
+   * `A[first:first + width, first:first + width] += block`, `block` being a symmetric `width x
+   * width` row major matrix of which only the upper triangle is read. Sums of many `add_outer` on
+   * the same `first` can be collected in such a block first, so `A` is written once.
+   */
+  void add_block(size_t first, T const *block)
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+    assertm(first + this->width <= this->num_cols, "Block past the last column");
+
+    T *a = this->band.data() + first * this->width;
+    for (size_t i{0}; i < this->width; i++)
+    {
+      for (size_t j{i}; j < this->width; j++)
+      {
+        a[j - i] += block[i * this->width + j];
+      }
+      a += this->width;
+    }
+  }
+
+  /**
+   * `A += scale * other`, for instance to merge normal equations accumulated separately or to add
+   * a penalty to them. `other` may have a narrower band.
+   */
+  void add(BandedCholesky const &other, T scale = (T)1)
+  {
+    assertm(!this->factorized && !other.factorized, "Matrix already factorized");
+    assertm(
+        other.num_cols == this->num_cols && other.width <= this->width, "Matrix sizes differ"
+    );
+
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      for (size_t j{0}; j < other.width; j++)
+      {
+        this->band[k * this->width + j] += scale * other.band[k * other.width + j];
+      }
+    }
+  }
+
+  // `x^T A x`
+  [[nodiscard]] T quadratic_form(T const *x) const
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+
+    T sum{0};
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      T const *a_k = this->band.data() + k * this->width;
+      T row{a_k[0] * x[k]};
+      size_t const last{std::min(this->width, this->num_cols - k)};
+      for (size_t j{1}; j < last; j++)
+      {
+        row += (T)2 * a_k[j] * x[k + j];
+      }
+      sum += x[k] * row;
+    }
+    return sum;
+  }
+
+  /**
+   * Replaces the matrix by its factor `U`. Returns false as soon as a pivot is not clearly
+   * positive, i.e. when the matrix is singular or too ill-conditioned for the normal equations,
+   * the matrix is garbage from then on.
+   */
+  [[nodiscard]] bool factorize()
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+
+    T max_diagonal{0};
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      max_diagonal = std::max(max_diagonal, this->band[k * this->width]);
+    }
+    T const tolerance{
+        max_diagonal * std::numeric_limits<T>::epsilon() * static_cast<T>(this->width)
+    };
+
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      T *u_k = this->band.data() + k * this->width;
+      if (!(u_k[0] > tolerance))
+      {
+        return false;
+      }
+
+      u_k[0] = std::sqrt(u_k[0]);
+      size_t const last{std::min(this->width, this->num_cols - k)};
+      for (size_t j{1}; j < last; j++)
+      {
+        u_k[j] /= u_k[0];
+      }
+
+      // Update the trailing rows within reach of row `k`
+      for (size_t i{1}; i < last; i++)
+      {
+        T *a_i = u_k + i * this->width;
+        for (size_t j{i}; j < last; j++)
+        {
+          a_i[j - i] -= u_k[i] * u_k[j];
+        }
+      }
+    }
+
+    this->factorized = true;
+    return true;
+  }
+
+  /**
+   * Solves `A x = b` in place with the factorization, `b` holds `num_rhs` right-hand sides in row
+   * major order, i.e. `b[k * num_rhs + q]`.
+   */
+  void solve(T *b, size_t num_rhs = 1) const
+  {
+    this->solve_lower(b, num_rhs);
+    this->solve_upper(b, num_rhs);
+  }
+
+  // First half of `solve`, `U^T z = b` in place
+  void solve_lower(T *b, size_t num_rhs = 1) const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      T const *u_k = this->band.data() + k * this->width;
+      size_t const last{std::min(this->width, this->num_cols - k)};
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        T const z_k{b[k * num_rhs + q] / u_k[0]};
+        b[k * num_rhs + q] = z_k;
+        for (size_t j{1}; j < last; j++)
+        {
+          b[(k + j) * num_rhs + q] -= u_k[j] * z_k;
+        }
+      }
+    }
+  }
+
+  // Second half of `solve`, `U x = z` in place
+  void solve_upper(T *b, size_t num_rhs = 1) const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    for (size_t k{this->num_cols}; k-- > 0;)
+    {
+      T const *u_k = this->band.data() + k * this->width;
+      size_t const last{std::min(this->width, this->num_cols - k)};
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        T sum{b[k * num_rhs + q]};
+        for (size_t j{1}; j < last; j++)
+        {
+          sum -= u_k[j] * b[(k + j) * num_rhs + q];
+        }
+        b[k * num_rhs + q] = sum / u_k[0];
+      }
+    }
+  }
+
+  // `log(det(A))` from the factorization
+  [[nodiscard]] T log_determinant() const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    T sum{0};
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      sum += std::log(this->band[k * this->width]);
+    }
+    return (T)2 * sum;
+  }
+
+  /**
+   * The entries of `A^-1` within the band of `A`, in the same layout, from the factorization and
+   * in `O(n * width^2)` (Takahashi's recurrence). They are all it takes for `trace(A^-1 M)` with
+   * `M` banded as narrowly as `A`, without ever forming the dense inverse.
+   */
+  [[nodiscard]] std::vector<T> selected_inverse() const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    // Rows from the last one up, `Z(i, j) = (delta_ij / U(i, i) - sum_k U(i, k) Z(k, j)) / U(i, i)`
+    // only reads entries of rows below `i` within the band
+    std::vector<T> inverse(this->band.size(), (T)0);
+    auto z = [&](size_t i, size_t j) -> T
+    { return i <= j ? inverse[i * this->width + j - i] : inverse[j * this->width + i - j]; };
+    for (size_t i{this->num_cols}; i-- > 0;)
+    {
+      T const *u_i = this->band.data() + i * this->width;
+      size_t const last{std::min(this->width, this->num_cols - i)};
+      for (size_t j{last}; j-- > 0;)
+      {
+        T sum{j == 0 ? (T)1 / u_i[0] : (T)0};
+        for (size_t k{1}; k < last; k++)
+        {
+          sum -= u_i[k] * z(i + k, i + j);
+        }
+        inverse[i * this->width + j] = sum / u_i[0];
+      }
+    }
+    return inverse;
+  }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] size_t bandwidth() const { return this->width; }
+
+  [[nodiscard]] bool is_factorized() const { return this->factorized; }
+
+  // Upper band, of the matrix or of `U` once factorized, `(k, k + j)` at `[k * bandwidth() + j]`
+  T const *data() const { return this->band.data(); }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
@@ -0,0 +1,297 @@
+#ifndef BANDED_LU_HPP
+#define BANDED_LU_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Square matrix whose leading `n - border` rows and columns are banded, `lower` non-zero diagonals
+ * below the main one and `upper` above, while the last `border` rows and columns are dense, and its
+ * LU factorization with partial pivoting.
+ *
+ * That is the shape of B-spline collocation matrices with the samples sorted by knot interval:
+ * banded for open and clamped curves, and with the rows wrapping around the last control points
+ * of periodic curves moved to the dense border. Factorization and solves take `O(n * (lower +
+ * border) * (lower + upper + border))`, pivots are searched within the band only so the band of
+ * `U` grows to `lower + upper` and nothing fills in outside of it.
+ */
+template <typename T>
+class BandedLU
+{
+private:
+  size_t num_cols{0};
+  size_t lower{0};
+  size_t upper{0};
+  size_t border{0};
+
+  // Leading rows, `(i, j)` at `[i * width() + j + lower - i]` for `j` in `[i - lower, i + lower +
+  // upper]`, the extra `lower` diagonals make room for the row interchanges
+  std::vector<T> band{};
+  // Last `border` columns of the leading rows and last `border` rows, both row major
+  std::vector<T> right{};
+  std::vector<T> bottom{};
+  // Multipliers of the leading columns, `lower` per column, and row interchanges
+  std::vector<T> multipliers{};
+  std::vector<size_t> pivots{};
+  bool factorized{false};
+
+public:
+  BandedLU() = default;
+
+  BandedLU(size_t num_cols, size_t lower, size_t upper, size_t border = 0)
+      : num_cols{num_cols}, lower{lower}, upper{upper}, border{border},
+        band((num_cols - border) * (2 * lower + upper + 1), (T)0),
+        right((num_cols - border) * border, (T)0), bottom(border * num_cols, (T)0),
+        multipliers((num_cols - border) * lower, (T)0), pivots(num_cols, 0)
+  {
+    assertm(border <= num_cols, "The border cannot be larger than the matrix");
+  }
+
+  // Entry `A(i, j)`, which must lie in the band or in the border
+  T &at(size_t i, size_t j)
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+    assertm(i < this->num_cols && j < this->num_cols, "Outside of the matrix");
+
+    size_t const lead{this->num_cols - this->border};
+    if (i >= lead)
+    {
+      return this->bottom[(i - lead) * this->num_cols + j];
+    }
+    if (j >= lead)
+    {
+      return this->right[i * this->border + j - lead];
+    }
+    assertm(j + this->lower >= i && j <= i + this->upper, "Outside of the band");
+    return this->band[i * this->width() + j + this->lower - i];
+  }
+
+  /**
+   * Replaces the matrix by its factors. Returns false as soon as a pivot is negligible, i.e. when
+   * the matrix is singular, the matrix is garbage from then on.
+   */
+  [[nodiscard]] bool factorize()
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+
+    size_t const lead{this->num_cols - this->border};
+    size_t const w{this->width()};
+    size_t const reach{this->lower + this->upper};
+    auto u = [&](size_t i, size_t j) -> T & { return this->band[i * w + j + this->lower - i]; };
+
+    T max_entry{0};
+    for (auto const *values : {&this->band, &this->right, &this->bottom})
+    {
+      for (T value : *values)
+      {
+        max_entry = std::max(max_entry, std::abs(value));
+      }
+    }
+    T const tolerance{
+        max_entry * std::numeric_limits<T>::epsilon() * static_cast<T>(w + this->border)
+    };
+
+    for (size_t k{0}; k < lead; k++)
+    {
+      size_t const last_row{std::min(k + this->lower, lead - 1)};
+      size_t const last_col{std::min(k + reach, lead - 1)};
+
+      size_t pivot{k};
+      for (size_t i{k + 1}; i <= last_row; i++)
+      {
+        if (std::abs(u(i, k)) > std::abs(u(pivot, k)))
+        {
+          pivot = i;
+        }
+      }
+      if (!(std::abs(u(pivot, k)) > tolerance))
+      {
+        return false;
+      }
+      this->pivots[k] = pivot;
+      if (pivot != k)
+      {
+        for (size_t j{k}; j <= last_col; j++)
+        {
+          std::swap(u(k, j), u(pivot, j));
+        }
+        std::swap_ranges(
+            this->right.begin() + k * this->border,
+            this->right.begin() + (k + 1) * this->border,
+            this->right.begin() + pivot * this->border
+        );
+      }
+
+      T const *right_k = this->right.data() + k * this->border;
+      for (size_t i{k + 1}; i <= last_row; i++)
+      {
+        T const l{u(i, k) / u(k, k)};
+        this->multipliers[k * this->lower + i - k - 1] = l;
+        for (size_t j{k + 1}; j <= last_col; j++)
+        {
+          u(i, j) -= l * u(k, j);
+        }
+        T *right_i = this->right.data() + i * this->border;
+        for (size_t c{0}; c < this->border; c++)
+        {
+          right_i[c] -= l * right_k[c];
+        }
+      }
+
+      // The dense rows keep their multipliers in place
+      for (size_t r{0}; r < this->border; r++)
+      {
+        T *bottom_r = this->bottom.data() + r * this->num_cols;
+        T const l{bottom_r[k] / u(k, k)};
+        bottom_r[k] = l;
+        for (size_t j{k + 1}; j <= last_col; j++)
+        {
+          bottom_r[j] -= l * u(k, j);
+        }
+        for (size_t c{0}; c < this->border; c++)
+        {
+          bottom_r[lead + c] -= l * right_k[c];
+        }
+      }
+    }
+
+    // Dense LU of what is left in the corner, `S(r, c)` at `bottom[r * num_cols + lead + c]`
+    auto s = [&](size_t r, size_t c) -> T & { return this->bottom[r * this->num_cols + lead + c]; };
+    for (size_t k{0}; k < this->border; k++)
+    {
+      size_t pivot{k};
+      for (size_t r{k + 1}; r < this->border; r++)
+      {
+        if (std::abs(s(r, k)) > std::abs(s(pivot, k)))
+        {
+          pivot = r;
+        }
+      }
+      if (!(std::abs(s(pivot, k)) > tolerance))
+      {
+        return false;
+      }
+      this->pivots[lead + k] = lead + pivot;
+      if (pivot != k)
+      {
+        for (size_t c{0}; c < this->border; c++)
+        {
+          std::swap(s(k, c), s(pivot, c));
+        }
+      }
+      for (size_t r{k + 1}; r < this->border; r++)
+      {
+        T const l{s(r, k) / s(k, k)};
+        s(r, k) = l;
+        for (size_t c{k + 1}; c < this->border; c++)
+        {
+          s(r, c) -= l * s(k, c);
+        }
+      }
+    }
+
+    this->factorized = true;
+    return true;
+  }
+
+  /**
+   * Solves `A x = b` in place with the factorization, `b` holds `num_rhs` right-hand sides in row
+   * major order, i.e. `b[k * num_rhs + q]`.
+   */
+  void solve(T *b, size_t num_rhs = 1) const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    size_t const lead{this->num_cols - this->border};
+    size_t const w{this->width()};
+    size_t const reach{this->lower + this->upper};
+    auto u = [&](size_t i, size_t j) { return this->band[i * w + j + this->lower - i]; };
+    auto s = [&](size_t r, size_t c) { return this->bottom[r * this->num_cols + lead + c]; };
+    auto swap_rows = [&](size_t i, size_t j)
+    { std::swap_ranges(b + i * num_rhs, b + (i + 1) * num_rhs, b + j * num_rhs); };
+    auto axpy = [&](size_t i, T a, size_t j)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        b[i * num_rhs + q] -= a * b[j * num_rhs + q];
+      }
+    };
+
+    // L z = P b, the leading columns first and the corner last
+    for (size_t k{0}; k < lead; k++)
+    {
+      swap_rows(k, this->pivots[k]);
+      for (size_t i{k + 1}; i <= std::min(k + this->lower, lead - 1); i++)
+      {
+        axpy(i, this->multipliers[k * this->lower + i - k - 1], k);
+      }
+      for (size_t r{0}; r < this->border; r++)
+      {
+        axpy(lead + r, this->bottom[r * this->num_cols + k], k);
+      }
+    }
+    // The corner swaps moved whole rows, multipliers included, so they all come first
+    for (size_t k{0}; k < this->border; k++)
+    {
+      swap_rows(lead + k, this->pivots[lead + k]);
+    }
+    for (size_t k{0}; k < this->border; k++)
+    {
+      for (size_t r{k + 1}; r < this->border; r++)
+      {
+        axpy(lead + r, s(r, k), lead + k);
+      }
+    }
+
+    // U x = z, the corner first
+    for (size_t k{this->border}; k-- > 0;)
+    {
+      for (size_t c{k + 1}; c < this->border; c++)
+      {
+        axpy(lead + k, s(k, c), lead + c);
+      }
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        b[(lead + k) * num_rhs + q] /= s(k, k);
+      }
+    }
+    for (size_t k{lead}; k-- > 0;)
+    {
+      for (size_t j{k + 1}; j <= std::min(k + reach, lead - 1); j++)
+      {
+        axpy(k, u(k, j), j);
+      }
+      T const *right_k = this->right.data() + k * this->border;
+      for (size_t c{0}; c < this->border; c++)
+      {
+        axpy(k, right_k[c], lead + c);
+      }
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        b[k * num_rhs + q] /= u(k, k);
+      }
+    }
+  }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] bool is_factorized() const { return this->factorized; }
+
+private:
+  [[nodiscard]] size_t width() const { return 2 * this->lower + this->upper + 1; }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
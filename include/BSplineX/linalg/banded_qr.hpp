@@ -0,0 +1,252 @@
+#ifndef BANDED_QR_HPP
+#define BANDED_QR_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Least squares `min sum_i w_i (a_i^T x - y_i)^2` whose rows `a_i` have `width` consecutive
+ * non-zeros, kept as the triangular factor `R` of the QR factorization of the weighted rows, with
+ * `Q^T y` and the residual sum of squares. `R` is upper banded like the rows, so it is stored as the
+ * upper band of `BandedCholesky`, `R(k, k + j)` at `[k * width + j]`, and `Q` is never formed.
+ *
+ * `add_row` rotates a row into `R` with Givens rotations and `remove_row` takes it out with mixed
+ * hyperbolic rotations (Bojanczyk, Brent, Van Dooren and de Hoog), the downdating counterpart that
+ * keeps the factor well conditioned in practice. Both sweep the rows of `R` from the row's first
+ * column down to where nothing is left of it: `O(width^2)` when nothing has been added past the
+ * row yet, e.g. for samples sorted by `x`, and down to the last row otherwise. `solve` is a banded
+ * back substitution, `O(n * width)`.
+ */
+template <typename T>
+class BandedQR
+{
+private:
+  size_t num_cols{0};
+  size_t width{0};
+  std::vector<T> band{};
+  std::vector<T> rhs{};
+  T residual{0};
+
+  // The row being rotated in or out, from the current pivot column on
+  std::vector<T> work{};
+  // Rows touched by a downdate, restored when it fails
+  std::vector<T> saved_band{};
+  std::vector<T> saved_rhs{};
+
+public:
+  BandedQR() = default;
+
+  BandedQR(size_t num_cols, size_t width)
+      : num_cols{num_cols}, width{width}, band(num_cols * width, (T)0), rhs(num_cols, (T)0),
+        work(width)
+  {
+    assertm(width > 0, "The band must hold at least the diagonal");
+  }
+
+  /**
+   * Adds the row `weight * (a^T x - y)^2` where `a` is zero but for `a[first + j] = coeffs[j]`,
+   * `j < width`. That is one weighted sample of a B-spline fit.
+   */
+  void add_row(size_t first, T const *coeffs, T y, T weight = (T)1)
+  {
+    assertm(first + this->width <= this->num_cols, "Row past the last column");
+    assertm(weight >= (T)0, "Negative weight");
+
+    T const scale{std::sqrt(weight)};
+    std::transform(
+        coeffs, coeffs + this->width, this->work.begin(), [scale](T a) { return scale * a; }
+    );
+    this->rotate_in(first, scale * y);
+  }
+
+  /**
+   * Removes a row added before with the same values. Returns false, and leaves the factorization
+   * untouched, when what remains would be singular or too ill-conditioned, e.g. when it is the last
+   * row with a non-zero in some column.
+   */
+  [[nodiscard]] bool remove_row(size_t first, T const *coeffs, T y, T weight = (T)1)
+  {
+    assertm(first + this->width <= this->num_cols, "Row past the last column");
+    assertm(weight >= (T)0, "Negative weight");
+
+    T const scale{std::sqrt(weight)};
+    std::transform(
+        coeffs, coeffs + this->width, this->work.begin(), [scale](T a) { return scale * a; }
+    );
+    return this->rotate_out(first, scale * y);
+  }
+
+  /**
+   * Adds every row of `other`, its column `k` being column `offset + k` of this one. The rows of
+   * `R` stand for those of the weighted design matrix, so factorizations of disjoint sets of rows
+   * merge into the factorization of all of them, cheaply when merged by increasing `offset`.
+   */
+  void merge(BandedQR const &other, size_t offset)
+  {
+    assertm(other.width <= this->width, "Band too wide");
+    assertm(offset + other.num_cols <= this->num_cols, "Rows past the last column");
+
+    for (size_t k{0}; k < other.num_cols; k++)
+    {
+      T const *r_k = other.band.data() + k * other.width;
+      size_t const last{std::min(other.width, other.num_cols - k)};
+      std::fill(this->work.begin(), this->work.end(), (T)0);
+      std::copy(r_k, r_k + last, this->work.begin());
+      this->rotate_in(offset + k, other.rhs[k]);
+    }
+    this->residual += other.residual;
+  }
+
+  /**
+   * Writes the `cols()` unknowns to `x`. Returns false when `R` is singular or too ill-conditioned,
+   * e.g. when some column has no row.
+   */
+  [[nodiscard]] bool solve(T *x) const
+  {
+    T max_diagonal{0};
+    for (size_t k{0}; k < this->num_cols; k++)
+    {
+      max_diagonal = std::max(max_diagonal, this->band[k * this->width]);
+    }
+    T const tolerance{
+        max_diagonal * std::numeric_limits<T>::epsilon() * static_cast<T>(this->width)
+    };
+
+    for (size_t k{this->num_cols}; k-- > 0;)
+    {
+      T const *r_k = this->band.data() + k * this->width;
+      if (!(r_k[0] > tolerance))
+      {
+        return false;
+      }
+      T sum{this->rhs[k]};
+      size_t const last{std::min(this->width, this->num_cols - k)};
+      for (size_t j{1}; j < last; j++)
+      {
+        sum -= r_k[j] * x[k + j];
+      }
+      x[k] = sum / r_k[0];
+    }
+    return true;
+  }
+
+  // Drops every row
+  void reset()
+  {
+    std::fill(this->band.begin(), this->band.end(), (T)0);
+    std::fill(this->rhs.begin(), this->rhs.end(), (T)0);
+    this->residual = (T)0;
+  }
+
+  // `min sum_i w_i (a_i^T x - y_i)^2`, the residual sum of squares at the solution
+  [[nodiscard]] T residual_sum() const { return std::max(this->residual, (T)0); }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] size_t bandwidth() const { return this->width; }
+
+private:
+  // Nothing left of the row being rotated
+  [[nodiscard]] bool is_rotated() const
+  {
+    return std::all_of(this->work.begin(), this->work.end(), [](T a) { return a == (T)0; });
+  }
+
+  // Givens rotations of `work`, from column `first` on, into the rows of `R`
+  void rotate_in(size_t first, T y)
+  {
+    for (size_t k{first}; k < this->num_cols && !this->is_rotated(); k++)
+    {
+      T *r_k = this->band.data() + k * this->width;
+      T &z_k = this->rhs[k];
+      T const pivot{this->work[0]};
+      if (pivot != (T)0)
+      {
+        T const norm{std::hypot(r_k[0], pivot)};
+        T const c{r_k[0] / norm};
+        T const s{pivot / norm};
+        r_k[0] = norm;
+        for (size_t j{1}; j < this->width; j++)
+        {
+          T const r{r_k[j]};
+          r_k[j]            = c * r + s * this->work[j];
+          this->work[j - 1] = c * this->work[j] - s * r;
+        }
+        T const z{z_k};
+        z_k = c * z + s * y;
+        y   = c * y - s * z;
+      }
+      else
+      {
+        std::copy(this->work.begin() + 1, this->work.end(), this->work.begin());
+      }
+      this->work[this->width - 1] = (T)0;
+    }
+    this->residual += y * y;
+  }
+
+  // Mixed hyperbolic rotations taking `work`, from column `first` on, out of the rows of `R`
+  [[nodiscard]] bool rotate_out(size_t first, T y)
+  {
+    T const tolerance{std::numeric_limits<T>::epsilon() * static_cast<T>(this->width)};
+    this->saved_band.clear();
+    this->saved_rhs.clear();
+
+    for (size_t k{first}; k < this->num_cols && !this->is_rotated(); k++)
+    {
+      T *r_k = this->band.data() + k * this->width;
+      T &z_k = this->rhs[k];
+      this->saved_band.insert(this->saved_band.end(), r_k, r_k + this->width);
+      this->saved_rhs.push_back(z_k);
+
+      T const pivot{this->work[0]};
+      if (pivot != (T)0)
+      {
+        // R'^T R' = R^T R - a a^T row by row, `c^2 = 1 - rho^2` must stay clearly positive, which
+        // also rules out an empty pivot
+        T const rho{pivot / r_k[0]};
+        T const c_squared{((T)1 - rho) * ((T)1 + rho)};
+        if (!(c_squared > tolerance))
+        {
+          std::copy(
+              this->saved_band.begin(),
+              this->saved_band.end(),
+              this->band.begin() + first * this->width
+          );
+          std::copy(this->saved_rhs.begin(), this->saved_rhs.end(), this->rhs.begin() + first);
+          return false;
+        }
+        T const c{std::sqrt(c_squared)};
+        r_k[0] *= c;
+        for (size_t j{1}; j < this->width; j++)
+        {
+          r_k[j]            = (r_k[j] - rho * this->work[j]) / c;
+          this->work[j - 1] = c * this->work[j] - rho * r_k[j];
+        }
+        z_k = (z_k - rho * y) / c;
+        y   = c * y - rho * z_k;
+      }
+      else
+      {
+        std::copy(this->work.begin() + 1, this->work.end(), this->work.begin());
+      }
+      this->work[this->width - 1] = (T)0;
+    }
+    this->residual -= y * y;
+    return true;
+  }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
@@ -0,0 +1,137 @@
+#ifndef CIRCULANT_HPP
+#define CIRCULANT_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/fft.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Penalized least squares `min |A x - y|^2 + lambda |D x|^2` when `A` stacks `num_blocks`
+ * circulant blocks, rows interleaved, and `D` takes the cyclic `order`-th differences of `x`.
+ *
+ * Row `q * num_blocks + r` of `A` holds `kernels[r * width + t]` in column `(shifts[r] + q + t)
+ * modulo num_cols`, for `t < width`. That is the design matrix of a uniform periodic B-spline
+ * sampled on a grid of `num_blocks` points per knot interval over one period. Every matrix of the
+ * normal equations is then circulant and diagonalized by the discrete Fourier transform, so with
+ * `A_r(j)` the spectrum of block `r`
+ *
+ *   X(j) = sum_r conj(A_r(j)) Y_r(j) / (sum_r |A_r(j)|^2 + lambda * (2 - 2 cos(2 pi j / n))^order)
+ *
+ * The spectra are computed once at construction, every solve then takes `num_blocks + 1` FFTs of
+ * size `num_cols`, `O(N log n)` for `N` samples, and no matrix is ever formed.
+ */
+template <typename T>
+class CirculantLeastSquares
+{
+private:
+  size_t num_cols{0};
+  size_t num_blocks{0};
+  FFT<T> fft{};
+  // Transform of each block's first row, `num_blocks x num_cols`, i.e. `conj(A_r(j))`
+  std::vector<std::complex<T>> spectra{};
+  // `sum_r |A_r(j)|^2`
+  std::vector<T> gram{};
+
+public:
+  CirculantLeastSquares() = default;
+
+  CirculantLeastSquares(
+      size_t num_cols, size_t width, T const *kernels, size_t const *shifts, size_t num_blocks
+  )
+      : num_cols{num_cols}, num_blocks{num_blocks}, fft{num_cols},
+        spectra(num_cols * num_blocks, std::complex<T>{0}), gram(num_cols, (T)0)
+  {
+    assertm(num_cols > 0 && num_blocks > 0, "Empty system");
+
+    for (size_t r{0}; r < num_blocks; r++)
+    {
+      std::complex<T> *spectrum = this->spectra.data() + r * num_cols;
+      for (size_t t{0}; t < width; t++)
+      {
+        spectrum[(shifts[r] + t) % num_cols] += kernels[r * width + t];
+      }
+      this->fft.forward(spectrum);
+      for (size_t j{0}; j < num_cols; j++)
+      {
+        this->gram[j] += std::norm(spectrum[j]);
+      }
+    }
+  }
+
+  /**
+   * Writes the `cols()` unknowns to `x`, `y` holding `rows()` samples. Returns false when the
+   * system is singular or too ill-conditioned, e.g. when interpolating at the midpoints of the
+   * knot intervals with odd degree and an even number of control points.
+   */
+  [[nodiscard]] bool solve(T const *y, T *x, T lambda = (T)0, size_t order = 2) const
+  {
+    size_t const n{this->num_cols};
+    T const pi{std::acos((T)-1)};
+
+    T const max_gram{*std::max_element(this->gram.begin(), this->gram.end())};
+    T const tolerance{
+        max_gram * std::numeric_limits<T>::epsilon() * static_cast<T>(this->num_blocks + 1)
+    };
+    std::vector<T> denominator(n);
+    for (size_t j{0}; j < n; j++)
+    {
+      denominator[j] = this->gram[j];
+      if (lambda > (T)0)
+      {
+        T const sine{std::sin(pi * (T)j / (T)n)};
+        denominator[j] += lambda * std::pow((T)4 * sine * sine, (T)order);
+      }
+      if (!(denominator[j] > tolerance))
+      {
+        return false;
+      }
+    }
+
+    // sum_r conj(A_r) Y_r, block `r` taking every `num_blocks`-th sample from `r`
+    std::vector<std::complex<T>> total(n, std::complex<T>{0});
+    std::vector<std::complex<T>> work(n);
+    for (size_t r{0}; r < this->num_blocks; r++)
+    {
+      for (size_t q{0}; q < n; q++)
+      {
+        work[q] = y[q * this->num_blocks + r];
+      }
+      this->fft.forward(work.data());
+      std::complex<T> const *spectrum = this->spectra.data() + r * n;
+      for (size_t j{0}; j < n; j++)
+      {
+        total[j] += spectrum[j] * work[j];
+      }
+    }
+
+    for (size_t j{0}; j < n; j++)
+    {
+      total[j] /= denominator[j];
+    }
+    this->fft.inverse(total.data());
+    for (size_t k{0}; k < n; k++)
+    {
+      x[k] = total[k].real();
+    }
+    return true;
+  }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] size_t rows() const { return this->num_cols * this->num_blocks; }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
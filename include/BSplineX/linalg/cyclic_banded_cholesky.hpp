@@ -0,0 +1,246 @@
+#ifndef CYCLIC_BANDED_CHOLESKY_HPP
+#define CYCLIC_BANDED_CHOLESKY_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/banded_cholesky.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Symmetric positive definite matrix whose non-zeros `A(i, j)` are within `width - 1` of the
+ * diagonal cyclically, i.e. `min(|i - j|, n - |i - j|) < width`, and its bordered Cholesky
+ * factorization.
+ *
+ * That is the shape of the normal equations of periodic B-splines, whose design matrix wraps
+ * around the last control points. With `m = width - 1` and `A = [A11 A12; A12^T A22]` split before
+ * the last `m` rows and columns, `A11` is banded and the wrap-around entries all fall in the
+ * border `A12`, `A22`. The factorization is
+ *
+ *   A = [U^T 0; W^T V^T] [U W; 0 V],  U^T U = A11,  W = U^-T A12,  V^T V = A22 - W^T W,
+ *
+ * with `U` a `BandedCholesky`, `W` dense but only `m` columns wide and `V` an `m x m` dense
+ * Cholesky factor. Factorization and solves take `O(n * width^2)` and nothing fills in outside of
+ * the band and the border.
+ */
+template <typename T>
+class CyclicBandedCholesky
+{
+private:
+  size_t num_cols{0};
+  size_t width{0};
+  size_t border{0};
+  BandedCholesky<T> lead{};
+  // `A12` then `W`, `(lead, border)` row major, and `A22` then `V`, `(border, border)` row major
+  std::vector<T> right{};
+  std::vector<T> corner{};
+  bool factorized{false};
+
+public:
+  CyclicBandedCholesky() = default;
+
+  CyclicBandedCholesky(size_t num_cols, size_t width)
+      : num_cols{num_cols}, width{width}, border{std::min(width - 1, num_cols)},
+        lead{num_cols - this->border, width}, right((num_cols - this->border) * this->border, (T)0),
+        corner(this->border * this->border, (T)0)
+  {
+    assertm(width > 0, "The band must hold at least the diagonal");
+  }
+
+  // Upper entry `A(i, j)`, `i <= j`, within the cyclic band
+  T &at(size_t i, size_t j)
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+    assertm(i <= j && j < this->num_cols, "Outside of the upper triangle");
+
+    size_t const lead_cols{this->num_cols - this->border};
+    if (i >= lead_cols)
+    {
+      return this->corner[(i - lead_cols) * this->border + j - lead_cols];
+    }
+    if (j >= lead_cols)
+    {
+      return this->right[i * this->border + j - lead_cols];
+    }
+    return this->lead.at(i, j);
+  }
+
+  /**
+   * `A += other` with the indices of `other` taken modulo `cols()`. `other` spans the padded
+   * columns of a periodic B-spline, the last `width - 1` of which repeat the first ones, so the
+   * normal equations accumulated over them as if they were banded fold into the cyclic ones.
+   */
+  void fold(BandedCholesky<T> const &other)
+  {
+    assertm(!this->factorized && !other.is_factorized(), "Matrix already factorized");
+    assertm(other.bandwidth() <= this->width, "Band too wide");
+    assertm(other.cols() <= this->num_cols + this->width - 1, "Too many columns to fold");
+
+    T const *values = other.data();
+    for (size_t k{0}; k < other.cols(); k++)
+    {
+      size_t const last{std::min(other.bandwidth(), other.cols() - k)};
+      for (size_t j{0}; j < last; j++)
+      {
+        size_t row{k % this->num_cols};
+        size_t col{(k + j) % this->num_cols};
+        if (row > col)
+        {
+          std::swap(row, col);
+        }
+        // Past the wrap both ends of a diagonal entry alias the same column
+        this->at(row, col) += (j > 0 && row == col ? (T)2 : (T)1) * values[k * other.bandwidth() + j];
+      }
+    }
+  }
+
+  /**
+   * Replaces the matrix by its factors. Returns false as soon as a pivot is not clearly positive,
+   * i.e. when the matrix is singular or too ill-conditioned, the matrix is garbage from then on.
+   */
+  [[nodiscard]] bool factorize()
+  {
+    assertm(!this->factorized, "Matrix already factorized");
+
+    size_t const lead_cols{this->num_cols - this->border};
+    T max_diagonal{0};
+    for (size_t k{0}; k < lead_cols; k++)
+    {
+      max_diagonal = std::max(max_diagonal, this->lead.at(k, k));
+    }
+    for (size_t r{0}; r < this->border; r++)
+    {
+      max_diagonal = std::max(max_diagonal, this->corner[r * this->border + r]);
+    }
+    T const tolerance{
+        max_diagonal * std::numeric_limits<T>::epsilon() * static_cast<T>(this->width)
+    };
+
+    if (!this->lead.factorize())
+    {
+      return false;
+    }
+    this->lead.solve_lower(this->right.data(), this->border);
+
+    // A22 - W^T W, upper triangle
+    for (size_t k{0}; k < lead_cols; k++)
+    {
+      T const *w_k = this->right.data() + k * this->border;
+      for (size_t r{0}; r < this->border; r++)
+      {
+        for (size_t c{r}; c < this->border; c++)
+        {
+          this->corner[r * this->border + c] -= w_k[r] * w_k[c];
+        }
+      }
+    }
+
+    // Dense Cholesky of what is left in the corner
+    auto v = [&](size_t r, size_t c) -> T & { return this->corner[r * this->border + c]; };
+    for (size_t k{0}; k < this->border; k++)
+    {
+      if (!(v(k, k) > tolerance))
+      {
+        return false;
+      }
+      v(k, k) = std::sqrt(v(k, k));
+      for (size_t c{k + 1}; c < this->border; c++)
+      {
+        v(k, c) /= v(k, k);
+      }
+      for (size_t r{k + 1}; r < this->border; r++)
+      {
+        for (size_t c{r}; c < this->border; c++)
+        {
+          v(r, c) -= v(k, r) * v(k, c);
+        }
+      }
+    }
+
+    this->factorized = true;
+    return true;
+  }
+
+  /**
+   * Solves `A x = b` in place with the factorization, `b` holds `num_rhs` right-hand sides in row
+   * major order, i.e. `b[k * num_rhs + q]`.
+   */
+  void solve(T *b, size_t num_rhs = 1) const
+  {
+    assertm(this->factorized, "Matrix not factorized");
+
+    size_t const lead_cols{this->num_cols - this->border};
+    T *tail = b + lead_cols * num_rhs;
+    auto v  = [&](size_t r, size_t c) { return this->corner[r * this->border + c]; };
+
+    // U^T z1 = b1, V^T z2 = b2 - W^T z1
+    this->lead.solve_lower(b, num_rhs);
+    for (size_t k{0}; k < lead_cols; k++)
+    {
+      T const *w_k = this->right.data() + k * this->border;
+      for (size_t r{0}; r < this->border; r++)
+      {
+        for (size_t q{0}; q < num_rhs; q++)
+        {
+          tail[r * num_rhs + q] -= w_k[r] * b[k * num_rhs + q];
+        }
+      }
+    }
+    for (size_t k{0}; k < this->border; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        tail[k * num_rhs + q] /= v(k, k);
+        for (size_t r{k + 1}; r < this->border; r++)
+        {
+          tail[r * num_rhs + q] -= v(k, r) * tail[k * num_rhs + q];
+        }
+      }
+    }
+
+    // V x2 = z2, U x1 = z1 - W x2
+    for (size_t k{this->border}; k-- > 0;)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        T sum{tail[k * num_rhs + q]};
+        for (size_t c{k + 1}; c < this->border; c++)
+        {
+          sum -= v(k, c) * tail[c * num_rhs + q];
+        }
+        tail[k * num_rhs + q] = sum / v(k, k);
+      }
+    }
+    for (size_t k{0}; k < lead_cols; k++)
+    {
+      T const *w_k = this->right.data() + k * this->border;
+      for (size_t c{0}; c < this->border; c++)
+      {
+        for (size_t q{0}; q < num_rhs; q++)
+        {
+          b[k * num_rhs + q] -= w_k[c] * tail[c * num_rhs + q];
+        }
+      }
+    }
+    this->lead.solve_upper(b, num_rhs);
+  }
+
+  [[nodiscard]] size_t cols() const { return this->num_cols; }
+
+  [[nodiscard]] size_t bandwidth() const { return this->width; }
+
+  [[nodiscard]] bool is_factorized() const { return this->factorized; }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
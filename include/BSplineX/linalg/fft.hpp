@@ -0,0 +1,160 @@
+#ifndef FFT_HPP
+#define FFT_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Discrete Fourier transform of a fixed size `n`, `X[j] = sum_k x[k] exp(-2 pi i j k / n)`, in
+ * `O(n log n)` for any `n`.
+ *
+ * Powers of two go through an iterative radix-2 transform. Other sizes are turned into a circular
+ * convolution of power-of-two size at least `2n - 1` (Bluestein's chirp-z algorithm). Twiddles and
+ * chirps are computed once at construction, the transforms are const and reentrant.
+ */
+template <typename T>
+class FFT
+{
+private:
+  size_t num{0};
+  size_t padded{0};
+  // `exp(-2 pi i k / padded)`, `k < padded / 2`
+  std::vector<std::complex<T>> twiddles{};
+  // Bluestein only, `exp(-i pi k^2 / n)` and the transform of its conjugate wrapped around
+  std::vector<std::complex<T>> chirp{};
+  std::vector<std::complex<T>> chirp_spectrum{};
+
+public:
+  FFT() = default;
+
+  explicit FFT(size_t size) : num{size}, padded{1}
+  {
+    bool const power_of_two{size > 0 && (size & (size - 1)) == 0};
+    while (this->padded < (power_of_two ? size : 2 * size - 1))
+    {
+      this->padded *= 2;
+    }
+
+    T const pi{std::acos((T)-1)};
+    this->twiddles.resize(this->padded / 2);
+    for (size_t k{0}; k < this->twiddles.size(); k++)
+    {
+      this->twiddles[k] = std::polar((T)1, -(T)2 * pi * (T)k / (T)this->padded);
+    }
+    if (power_of_two || size == 0)
+    {
+      return;
+    }
+
+    // `k^2` modulo `2n` keeps the angles small, and accurate, for large `k`
+    this->chirp.resize(size);
+    for (size_t k{0}; k < size; k++)
+    {
+      size_t const square{(k * k) % (2 * size)};
+      this->chirp[k] = std::polar((T)1, -pi * (T)square / (T)size);
+    }
+    this->chirp_spectrum.assign(this->padded, std::complex<T>{0});
+    this->chirp_spectrum[0] = std::conj(this->chirp[0]);
+    for (size_t k{1}; k < size; k++)
+    {
+      this->chirp_spectrum[k]                = std::conj(this->chirp[k]);
+      this->chirp_spectrum[this->padded - k] = std::conj(this->chirp[k]);
+    }
+    this->radix2(this->chirp_spectrum.data(), false);
+  }
+
+  // `data` holds `size()` values, replaced by their transform
+  void forward(std::complex<T> *data) const
+  {
+    if (this->chirp.empty())
+    {
+      this->radix2(data, false);
+      return;
+    }
+
+    // X[j] = chirp[j] * sum_k (x[k] chirp[k]) conj(chirp[j - k])
+    std::vector<std::complex<T>> work(this->padded, std::complex<T>{0});
+    for (size_t k{0}; k < this->num; k++)
+    {
+      work[k] = data[k] * this->chirp[k];
+    }
+    this->radix2(work.data(), false);
+    for (size_t k{0}; k < this->padded; k++)
+    {
+      work[k] *= this->chirp_spectrum[k];
+    }
+    this->radix2(work.data(), true);
+    T const scale{(T)1 / (T)this->padded};
+    for (size_t j{0}; j < this->num; j++)
+    {
+      data[j] = work[j] * this->chirp[j] * scale;
+    }
+  }
+
+  // Inverse of `forward`, scaling included
+  void inverse(std::complex<T> *data) const
+  {
+    std::for_each(data, data + this->num, [](std::complex<T> &value) { value = std::conj(value); });
+    this->forward(data);
+    T const scale{(T)1 / (T)this->num};
+    std::for_each(
+        data,
+        data + this->num,
+        [scale](std::complex<T> &value) { value = std::conj(value) * scale; }
+    );
+  }
+
+  [[nodiscard]] size_t size() const { return this->num; }
+
+private:
+  // Unscaled transform of `padded` values, with `exp(+...)` when `conjugate`
+  void radix2(std::complex<T> *data, bool conjugate) const
+  {
+    size_t const n{this->padded};
+    for (size_t i{1}, j{0}; i < n; i++)
+    {
+      size_t bit{n >> 1};
+      for (; j & bit; bit >>= 1)
+      {
+        j ^= bit;
+      }
+      j ^= bit;
+      if (i < j)
+      {
+        std::swap(data[i], data[j]);
+      }
+    }
+
+    for (size_t length{2}; length <= n; length *= 2)
+    {
+      size_t const half{length / 2};
+      size_t const stride{n / length};
+      for (size_t start{0}; start < n; start += length)
+      {
+        for (size_t k{0}; k < half; k++)
+        {
+          std::complex<T> const twiddle{
+              conjugate ? std::conj(this->twiddles[k * stride]) : this->twiddles[k * stride]
+          };
+          std::complex<T> const odd{data[start + k + half] * twiddle};
+          data[start + k + half] = data[start + k] - odd;
+          data[start + k] += odd;
+        }
+      }
+    }
+  }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
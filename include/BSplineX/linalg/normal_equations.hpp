@@ -0,0 +1,177 @@
+#ifndef NORMAL_EQUATIONS_HPP
+#define NORMAL_EQUATIONS_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+#include "BSplineX/linalg/banded_cholesky.hpp"
+#include "BSplineX/linalg/cyclic_banded_cholesky.hpp"
+
+namespace bsplinex::linalg
+{
+
+/**
+ * Running normal equations `A^T A x = A^T y` of a least-squares problem whose rows hold `width`
+ * consecutive non-zeros, for `num_rhs` right-hand sides at once.
+ *
+ * Rows are folded in one at a time and forgotten, so the state is `O(num_cols * (width +
+ * num_rhs))` whatever the number of rows: `A^T A` in a `BandedCholesky`, `A^T y` in row major
+ * order and `y^T y`. Accumulators filled separately, e.g. by different threads or from different
+ * files, can be merged with `add`.
+ */
+template <typename T>
+class NormalEquations
+{
+private:
+  BandedCholesky<T> gram{};
+  std::vector<T> rhs{};
+  std::vector<T> squares{};
+  size_t num_rhs{0};
+  size_t num_rows{0};
+
+public:
+  NormalEquations() = default;
+
+  NormalEquations(size_t num_cols, size_t width, size_t num_rhs = 1)
+      : gram{num_cols, width}, rhs(num_cols * num_rhs, (T)0), squares(num_rhs, (T)0),
+        num_rhs{num_rhs}
+  {
+  }
+
+  // Row `[coeffs[0], ..., coeffs[width - 1]]` starting at column `first`, right-hand sides `y[q]`
+  void add_row(size_t first, T const *coeffs, T const *y, T weight = (T)1)
+  {
+    this->gram.add_outer(first, coeffs, weight);
+
+    T *rhs_first = this->rhs.data() + first * this->num_rhs;
+    for (size_t j{0}; j < this->gram.bandwidth(); j++)
+    {
+      T const scaled{weight * coeffs[j]};
+      for (size_t q{0}; q < this->num_rhs; q++)
+      {
+        rhs_first[j * this->num_rhs + q] += scaled * y[q];
+      }
+    }
+    for (size_t q{0}; q < this->num_rhs; q++)
+    {
+      this->squares[q] += weight * y[q] * y[q];
+    }
+    this->num_rows++;
+  }
+
+  /**
+   * Adds `num_rows` rows starting at column `first` at once, through their contribution
+   * `gram_block` to `A^T A` (`width x width`, row major, upper triangle), `rhs_block` to `A^T y`
+   * (`width x num_rhs`, row major) and `squares_block` to `y^T y` (`num_rhs`), see
+   * `BandedCholesky::add_block`.
+   */
+  void add_block(
+      size_t first,
+      T const *gram_block,
+      T const *rhs_block,
+      T const *squares_block,
+      size_t num_rows
+  )
+  {
+    this->gram.add_block(first, gram_block);
+
+    T *rhs_first = this->rhs.data() + first * this->num_rhs;
+    for (size_t k{0}; k < this->gram.bandwidth() * this->num_rhs; k++)
+    {
+      rhs_first[k] += rhs_block[k];
+    }
+    for (size_t q{0}; q < this->num_rhs; q++)
+    {
+      this->squares[q] += squares_block[q];
+    }
+    this->num_rows += num_rows;
+  }
+
+  void add(NormalEquations const &other)
+  {
+    assertm(other.num_rhs == this->num_rhs, "Different number of right-hand sides");
+
+    this->gram.add(other.gram);
+    for (size_t k{0}; k < this->rhs.size(); k++)
+    {
+      this->rhs[k] += other.rhs[k];
+    }
+    for (size_t q{0}; q < this->num_rhs; q++)
+    {
+      this->squares[q] += other.squares[q];
+    }
+    this->num_rows += other.num_rows;
+  }
+
+  /**
+   * Writes the `cols() x num_rhs` solution to `x` in row major order, the accumulated state is left
+   * untouched so more rows can follow. Returns false when `A^T A` is singular or too
+   * ill-conditioned, e.g. when some columns are not covered by any row.
+   */
+  [[nodiscard]] bool solve(T *x) const
+  {
+    BandedCholesky<T> factor{this->gram};
+    if (!factor.factorize())
+    {
+      return false;
+    }
+    std::copy(this->rhs.begin(), this->rhs.end(), x);
+    factor.solve(x, this->num_rhs);
+    return true;
+  }
+
+  /**
+   * Like `solve`, when the columns from `num_cols` on alias the first ones, as the padded control
+   * points of periodic B-splines do. They are folded over and the `num_cols x num_rhs` solution
+   * comes from the cyclic-banded system, see `CyclicBandedCholesky`.
+   */
+  [[nodiscard]] bool solve_periodic(T *x, size_t num_cols) const
+  {
+    assertm(num_cols <= this->cols(), "More columns than accumulated");
+
+    CyclicBandedCholesky<T> factor{num_cols, this->gram.bandwidth()};
+    factor.fold(this->gram);
+    if (!factor.factorize())
+    {
+      return false;
+    }
+    std::fill_n(x, num_cols * this->num_rhs, (T)0);
+    for (size_t k{0}; k < this->rhs.size(); k++)
+    {
+      x[k % (num_cols * this->num_rhs)] += this->rhs[k];
+    }
+    factor.solve(x, this->num_rhs);
+    return true;
+  }
+
+  // Drops every row added so far, keeping the sizes
+  void reset()
+  {
+    this->gram = BandedCholesky<T>{this->gram.cols(), this->gram.bandwidth()};
+    std::fill(this->rhs.begin(), this->rhs.end(), (T)0);
+    std::fill(this->squares.begin(), this->squares.end(), (T)0);
+    this->num_rows = 0;
+  }
+
+  [[nodiscard]] size_t cols() const { return this->gram.cols(); }
+
+  [[nodiscard]] size_t rows() const { return this->num_rows; }
+
+  [[nodiscard]] size_t rhs_size() const { return this->num_rhs; }
+
+  BandedCholesky<T> const &get_gram() const { return this->gram; }
+
+  // `A^T y`, `(k, q)` at `[k * rhs_size() + q]`
+  T const *rhs_data() const { return this->rhs.data(); }
+
+  // `y^T y` of every right-hand side, so that residuals follow from the solution alone
+  T const *squares_data() const { return this->squares.data(); }
+};
+
+} // namespace bsplinex::linalg
+
+#endif
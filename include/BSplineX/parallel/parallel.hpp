@@ -0,0 +1,117 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+// Standard includes
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/defines.hpp"
+
+/**
+ * Minimal fork-join helpers used by the parallel batch algorithms.
+ *
+ * The work is cut into chunks of `chunk_size` items that the threads claim one at a time from a
+ * shared atomic counter. A thread that finishes early simply claims the next chunk, so lanes stay
+ * balanced even when some chunks are much more expensive than others (e.g. extrapolated values
+ * clustered in one part of the input), without the bookkeeping of per-thread work-stealing deques.
+ *
+ * The calling thread takes part in the work, so `num_threads == 1` runs inline without spawning.
+ */
+
+// 4096 doubles in and 4096 out fit in a typical L2 cache together with the knots being searched
+constexpr size_t PARALLEL_CHUNK_SIZE = 4096;
+
+namespace bsplinex::parallel
+{
+
+// Number of threads to use when the caller passes 0, never less than 1
+inline size_t default_threads()
+{
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+/**
+ * Calls `f(first, last)` on every chunk `[first, last[` of `[0, num_items[`, spread over
+ * `num_threads` threads (0 for `default_threads()`). `f` must be safe to call concurrently on
+ * distinct chunks. The first exception thrown by `f` is rethrown once all threads have stopped;
+ * chunks not yet claimed at that point are skipped.
+ */
+template <typename F>
+void for_each_chunk(size_t num_items, size_t chunk_size, size_t num_threads, F &&f)
+{
+  assertm(chunk_size > 0, "Chunk size must be positive");
+
+  size_t num_chunks = (num_items + chunk_size - 1) / chunk_size;
+  num_threads       = std::min(num_threads == 0 ? default_threads() : num_threads, num_chunks);
+
+  if (num_threads <= 1)
+  {
+    for (size_t first{0}; first < num_items; first += chunk_size)
+    {
+      f(first, std::min(first + chunk_size, num_items));
+    }
+    return;
+  }
+
+  std::atomic<size_t> next_chunk{0};
+  std::exception_ptr error{nullptr};
+  std::mutex error_mutex{};
+
+  auto worker = [&]()
+  {
+    for (size_t chunk{next_chunk++}; chunk < num_chunks; chunk = next_chunk++)
+    {
+      try
+      {
+        size_t first = chunk * chunk_size;
+        f(first, std::min(first + chunk_size, num_items));
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock{error_mutex};
+        if (!error)
+        {
+          error = std::current_exception();
+        }
+        // Make every thread run out of chunks
+        next_chunk = num_chunks;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads{};
+  threads.reserve(num_threads - 1);
+  for (size_t i{1}; i < num_threads; i++)
+  {
+    try
+    {
+      threads.emplace_back(worker);
+    }
+    catch (std::system_error const &)
+    {
+      // Out of threads, the ones already running (and this one) pick up the slack
+      break;
+    }
+  }
+  worker();
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace bsplinex::parallel
+
+#endif
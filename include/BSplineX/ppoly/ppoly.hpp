@@ -0,0 +1,158 @@
+#ifndef PPOLY_HPP
+#define PPOLY_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/knots/knots.hpp"
+#include "BSplineX/types.hpp"
+
+/**
+ * Piecewise-polynomial (power basis) form of a B-spline.
+ *
+ * On every non-empty knot interval `[t_i, t_{i+1}[` the spline is a polynomial of degree `p`,
+ * which we store by its coefficients in `u = x - t_i`:
+ *   s(x) = c_{i,0} + c_{i,1} u + ... + c_{i,p} u^p
+ *
+ * The coefficients are obtained once by running de Boor with polynomials in `u` as support, which
+ * is exact up to round-off. Evaluation is then the same interval lookup as `knots::Knots::find`
+ * (hence the same `Extrapolation` semantics) followed by a Horner step of degree `p`, instead of
+ * the O(p^2) de Boor recurrence.
+ *
+ * The conversion is a snapshot: refitting the original B-spline does not update it.
+ */
+
+namespace bsplinex::ppoly
+{
+
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+class PPoly
+{
+private:
+  knots::Knots<T, C, BC, EXT> knots{};
+  size_t degree{0};
+  std::vector<T> coefficients{};
+
+public:
+  PPoly() { DEBUG_LOG_CALL(); }
+
+  PPoly(bspline::BSpline<T, C, BC, EXT> const &bspline)
+      : knots{bspline.get_knots()}, degree{bspline.get_degree()}
+  {
+    DEBUG_LOG_CALL();
+    this->convert(bspline.get_control_points());
+  }
+
+  T evaluate(T value) const
+  {
+    auto index_value_pair = this->knots.find(value);
+    return this->horner(index_value_pair.first, index_value_pair.second);
+  }
+
+  std::vector<T> evaluate(std::vector<T> const &values) const
+  {
+    std::vector<T> results(values.size());
+    this->evaluate(values.data(), results.data(), values.size());
+    return results;
+  }
+
+  void evaluate(T const *values, T *results, size_t num_values) const
+  {
+    for (size_t i{0}; i < num_values; i++)
+    {
+      auto index_value_pair = this->knots.find(values[i]);
+      results[i]            = this->horner(index_value_pair.first, index_value_pair.second);
+    }
+  }
+
+  // Coefficients of the interval starting at knot `index`, lowest order first
+  std::vector<T> get_coefficients(size_t index) const
+  {
+    assertm(index >= this->degree && index < this->num_intervals() + this->degree, "Out of bounds");
+    auto first = this->coefficients.begin() + (index - this->degree) * (this->degree + 1);
+    return {first, first + this->degree + 1};
+  }
+
+  [[nodiscard]] size_t num_intervals() const { return this->knots.size() - 2 * this->degree - 1; }
+
+  [[nodiscard]] size_t get_degree() const { return this->degree; }
+
+private:
+  T horner(size_t index, T value) const
+  {
+    T const *coeffs = this->coefficients.data() + (index - this->degree) * (this->degree + 1);
+    T u             = value - this->knots.data()[index];
+    T res           = coeffs[this->degree];
+    for (size_t k{this->degree}; k > 0; k--)
+    {
+      res = res * u + coeffs[k - 1];
+    }
+    return res;
+  }
+
+  void convert(control_points::ControlPoints<T, BC> const &control_points)
+  {
+    size_t const p  = this->degree;
+    size_t const k1 = p + 1;
+    T const *t      = this->knots.data();
+
+    this->coefficients.assign(this->num_intervals() * k1, (T)0);
+
+    // support[j * k1 + k] is the coefficient of u^k of the j-th de Boor support polynomial
+    std::vector<T> support(k1 * k1);
+    std::vector<T> diff(k1);
+
+    for (size_t index{p}; index < this->num_intervals() + p; index++)
+    {
+      if (t[index + 1] <= t[index])
+      {
+        // Empty interval, `knots.find` never lands here
+        continue;
+      }
+
+      std::fill(support.begin(), support.end(), (T)0);
+      for (size_t j{0}; j <= p; j++)
+      {
+        support[j * k1] = control_points.at(j + index - p);
+      }
+
+      for (size_t r{1}; r <= p; r++)
+      {
+        for (size_t j{p}; j >= r; j--)
+        {
+          // alpha(u) = (u + t_index - left) / (right - left) = a0 + a1 u
+          T left  = t[j + index - p];
+          T right = t[j + 1 + index - r];
+          T a1    = (T)1 / (right - left);
+          T a0    = (t[index] - left) * a1;
+
+          T *current        = support.data() + j * k1;
+          T const *previous = support.data() + (j - 1) * k1;
+          for (size_t k{0}; k < r; k++)
+          {
+            diff[k] = current[k] - previous[k];
+          }
+          // current = previous + alpha * (current - previous), degree grows from r - 1 to r
+          current[0] = previous[0] + a0 * diff[0];
+          for (size_t k{1}; k <= r; k++)
+          {
+            current[k] = previous[k] + a0 * (k < r ? diff[k] : (T)0) + a1 * diff[k - 1];
+          }
+        }
+      }
+
+      std::copy_n(
+          support.data() + p * k1, k1, this->coefficients.data() + (index - p) * k1
+      );
+    }
+  }
+};
+
+} // namespace bsplinex::ppoly
+
+#endif
@@ -0,0 +1,425 @@
+#ifndef SIMD_HPP
+#define SIMD_HPP
+
+// Standard includes
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+// BSplineX includes
+#include "BSplineX/deboor/deboor.hpp"
+#include "BSplineX/defines.hpp"
+#include "BSplineX/types.hpp"
+
+/**
+ * Hand-vectorised batch kernels with runtime instruction set dispatch.
+ *
+ * Each instruction set gets a `Vec` wrapper (`Sse`, `Avx2` and `Avx512`, for `float` and `double`,
+ * i.e. 2/4, 4/8 and 8/16 lanes) whose members are compiled with the matching `target` attribute.
+ * The kernels in `simd_kernels.hpp` are instantiated once per wrapper, and the entry points below
+ * pick one from the `Isa` detected with CPUID at first use, so one binary runs on any x86-64 CPU.
+ *
+ * Everything falls back to the scalar kernels of `deboor.hpp`, which stay the reference, on other
+ * architectures and compilers, for other types, and for degrees above `STACK_MAX_DEGREE`.
+ */
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define BSPLINEX_SIMD_X86
+// Some GCC versions warn about the placeholder operands of the gather and AVX-512 intrinsics
+#ifdef __GNUC__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+#ifdef __GNUC__
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+namespace bsplinex::simd
+{
+
+// Best instruction set supported by this CPU, detected once
+inline Isa detect_isa()
+{
+#ifdef BSPLINEX_SIMD_X86
+  static Isa const isa = []()
+  {
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+      return Isa::AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+      return Isa::AVX2;
+    }
+    if (__builtin_cpu_supports("sse4.1"))
+    {
+      return Isa::SSE;
+    }
+    return Isa::SCALAR;
+  }();
+  return isa;
+#else
+  return Isa::SCALAR;
+#endif
+}
+
+// `Isa::AUTO` becomes the detected instruction set, anything the CPU lacks is lowered to it
+inline Isa resolve_isa(Isa isa)
+{
+  Isa best = detect_isa();
+  if (isa == Isa::AUTO)
+  {
+    return best;
+  }
+  return static_cast<int>(isa) < static_cast<int>(best) ? isa : best;
+}
+
+#ifdef BSPLINEX_SIMD_X86
+
+#define BSPLINEX_SIMD_SSE __attribute__((target("sse4.1"), always_inline)) static inline
+#define BSPLINEX_SIMD_AVX2 __attribute__((target("avx2"), always_inline)) static inline
+#define BSPLINEX_SIMD_AVX512 __attribute__((target("avx512f"), always_inline)) static inline
+
+template <typename T>
+struct Sse;
+
+template <>
+struct Sse<double>
+{
+  using reg                     = __m128d;
+  static constexpr size_t width = 2;
+
+  BSPLINEX_SIMD_SSE reg load(double const *p) { return _mm_loadu_pd(p); }
+  BSPLINEX_SIMD_SSE void store(double *p, reg a) { _mm_storeu_pd(p, a); }
+  BSPLINEX_SIMD_SSE reg set1(double a) { return _mm_set1_pd(a); }
+  BSPLINEX_SIMD_SSE reg add(reg a, reg b) { return _mm_add_pd(a, b); }
+  BSPLINEX_SIMD_SSE reg sub(reg a, reg b) { return _mm_sub_pd(a, b); }
+  BSPLINEX_SIMD_SSE reg mul(reg a, reg b) { return _mm_mul_pd(a, b); }
+  BSPLINEX_SIMD_SSE reg div(reg a, reg b) { return _mm_div_pd(a, b); }
+
+  // No gather instruction before AVX2
+  BSPLINEX_SIMD_SSE reg gather(double const *base, int32_t const *idx, int32_t offset)
+  {
+    return _mm_set_pd(base[idx[1] + offset], base[idx[0] + offset]);
+  }
+
+  BSPLINEX_SIMD_SSE bool in_range(reg x, reg lo, reg hi)
+  {
+    return _mm_movemask_pd(_mm_and_pd(_mm_cmpge_pd(x, lo), _mm_cmplt_pd(x, hi))) == 0x3;
+  }
+
+  BSPLINEX_SIMD_SSE void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m128i i = _mm_add_epi32(_mm_cvttpd_epi32(scaled), _mm_set1_epi32(add));
+    _mm_storel_epi64(reinterpret_cast<__m128i *>(out), _mm_min_epi32(i, _mm_set1_epi32(last)));
+  }
+};
+
+template <>
+struct Sse<float>
+{
+  using reg                     = __m128;
+  static constexpr size_t width = 4;
+
+  BSPLINEX_SIMD_SSE reg load(float const *p) { return _mm_loadu_ps(p); }
+  BSPLINEX_SIMD_SSE void store(float *p, reg a) { _mm_storeu_ps(p, a); }
+  BSPLINEX_SIMD_SSE reg set1(float a) { return _mm_set1_ps(a); }
+  BSPLINEX_SIMD_SSE reg add(reg a, reg b) { return _mm_add_ps(a, b); }
+  BSPLINEX_SIMD_SSE reg sub(reg a, reg b) { return _mm_sub_ps(a, b); }
+  BSPLINEX_SIMD_SSE reg mul(reg a, reg b) { return _mm_mul_ps(a, b); }
+  BSPLINEX_SIMD_SSE reg div(reg a, reg b) { return _mm_div_ps(a, b); }
+
+  BSPLINEX_SIMD_SSE reg gather(float const *base, int32_t const *idx, int32_t offset)
+  {
+    return _mm_set_ps(
+        base[idx[3] + offset], base[idx[2] + offset], base[idx[1] + offset], base[idx[0] + offset]
+    );
+  }
+
+  BSPLINEX_SIMD_SSE bool in_range(reg x, reg lo, reg hi)
+  {
+    return _mm_movemask_ps(_mm_and_ps(_mm_cmpge_ps(x, lo), _mm_cmplt_ps(x, hi))) == 0xF;
+  }
+
+  BSPLINEX_SIMD_SSE void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m128i i = _mm_add_epi32(_mm_cvttps_epi32(scaled), _mm_set1_epi32(add));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_min_epi32(i, _mm_set1_epi32(last)));
+  }
+};
+
+template <typename T>
+struct Avx2;
+
+template <>
+struct Avx2<double>
+{
+  using reg                     = __m256d;
+  static constexpr size_t width = 4;
+
+  BSPLINEX_SIMD_AVX2 reg load(double const *p) { return _mm256_loadu_pd(p); }
+  BSPLINEX_SIMD_AVX2 void store(double *p, reg a) { _mm256_storeu_pd(p, a); }
+  BSPLINEX_SIMD_AVX2 reg set1(double a) { return _mm256_set1_pd(a); }
+  BSPLINEX_SIMD_AVX2 reg add(reg a, reg b) { return _mm256_add_pd(a, b); }
+  BSPLINEX_SIMD_AVX2 reg sub(reg a, reg b) { return _mm256_sub_pd(a, b); }
+  BSPLINEX_SIMD_AVX2 reg mul(reg a, reg b) { return _mm256_mul_pd(a, b); }
+  BSPLINEX_SIMD_AVX2 reg div(reg a, reg b) { return _mm256_div_pd(a, b); }
+
+  BSPLINEX_SIMD_AVX2 reg gather(double const *base, int32_t const *idx, int32_t offset)
+  {
+    // Four plain loads beat the four lane gather instruction on many CPUs, especially since the
+    // microcode mitigations for gather data sampling
+    return _mm256_set_pd(
+        base[idx[3] + offset], base[idx[2] + offset], base[idx[1] + offset], base[idx[0] + offset]
+    );
+  }
+
+  BSPLINEX_SIMD_AVX2 bool in_range(reg x, reg lo, reg hi)
+  {
+    return _mm256_movemask_pd(
+               _mm256_and_pd(_mm256_cmp_pd(x, lo, _CMP_GE_OQ), _mm256_cmp_pd(x, hi, _CMP_LT_OQ))
+           ) == 0xF;
+  }
+
+  BSPLINEX_SIMD_AVX2 void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m128i i = _mm_add_epi32(_mm256_cvttpd_epi32(scaled), _mm_set1_epi32(add));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out), _mm_min_epi32(i, _mm_set1_epi32(last)));
+  }
+};
+
+template <>
+struct Avx2<float>
+{
+  using reg                     = __m256;
+  static constexpr size_t width = 8;
+
+  BSPLINEX_SIMD_AVX2 reg load(float const *p) { return _mm256_loadu_ps(p); }
+  BSPLINEX_SIMD_AVX2 void store(float *p, reg a) { _mm256_storeu_ps(p, a); }
+  BSPLINEX_SIMD_AVX2 reg set1(float a) { return _mm256_set1_ps(a); }
+  BSPLINEX_SIMD_AVX2 reg add(reg a, reg b) { return _mm256_add_ps(a, b); }
+  BSPLINEX_SIMD_AVX2 reg sub(reg a, reg b) { return _mm256_sub_ps(a, b); }
+  BSPLINEX_SIMD_AVX2 reg mul(reg a, reg b) { return _mm256_mul_ps(a, b); }
+  BSPLINEX_SIMD_AVX2 reg div(reg a, reg b) { return _mm256_div_ps(a, b); }
+
+  BSPLINEX_SIMD_AVX2 reg gather(float const *base, int32_t const *idx, int32_t offset)
+  {
+    __m256i i = _mm256_add_epi32(
+        _mm256_load_si256(reinterpret_cast<__m256i const *>(idx)), _mm256_set1_epi32(offset)
+    );
+    return _mm256_i32gather_ps(base, i, 4);
+  }
+
+  BSPLINEX_SIMD_AVX2 bool in_range(reg x, reg lo, reg hi)
+  {
+    return _mm256_movemask_ps(
+               _mm256_and_ps(_mm256_cmp_ps(x, lo, _CMP_GE_OQ), _mm256_cmp_ps(x, hi, _CMP_LT_OQ))
+           ) == 0xFF;
+  }
+
+  BSPLINEX_SIMD_AVX2 void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m256i i = _mm256_add_epi32(_mm256_cvttps_epi32(scaled), _mm256_set1_epi32(add));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(out), _mm256_min_epi32(i, _mm256_set1_epi32(last))
+    );
+  }
+};
+
+template <typename T>
+struct Avx512;
+
+template <>
+struct Avx512<double>
+{
+  using reg                     = __m512d;
+  static constexpr size_t width = 8;
+
+  BSPLINEX_SIMD_AVX512 reg load(double const *p) { return _mm512_loadu_pd(p); }
+  BSPLINEX_SIMD_AVX512 void store(double *p, reg a) { _mm512_storeu_pd(p, a); }
+  BSPLINEX_SIMD_AVX512 reg set1(double a) { return _mm512_set1_pd(a); }
+  BSPLINEX_SIMD_AVX512 reg add(reg a, reg b) { return _mm512_add_pd(a, b); }
+  BSPLINEX_SIMD_AVX512 reg sub(reg a, reg b) { return _mm512_sub_pd(a, b); }
+  BSPLINEX_SIMD_AVX512 reg mul(reg a, reg b) { return _mm512_mul_pd(a, b); }
+  BSPLINEX_SIMD_AVX512 reg div(reg a, reg b) { return _mm512_div_pd(a, b); }
+
+  BSPLINEX_SIMD_AVX512 reg gather(double const *base, int32_t const *idx, int32_t offset)
+  {
+    __m256i i = _mm256_add_epi32(
+        _mm256_load_si256(reinterpret_cast<__m256i const *>(idx)), _mm256_set1_epi32(offset)
+    );
+    return _mm512_i32gather_pd(i, base, 8);
+  }
+
+  BSPLINEX_SIMD_AVX512 bool in_range(reg x, reg lo, reg hi)
+  {
+    return (_mm512_cmp_pd_mask(x, lo, _CMP_GE_OQ) & _mm512_cmp_pd_mask(x, hi, _CMP_LT_OQ)) == 0xFF;
+  }
+
+  BSPLINEX_SIMD_AVX512 void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m256i i = _mm256_add_epi32(_mm512_cvttpd_epi32(scaled), _mm256_set1_epi32(add));
+    _mm256_storeu_si256(
+        reinterpret_cast<__m256i *>(out), _mm256_min_epi32(i, _mm256_set1_epi32(last))
+    );
+  }
+};
+
+template <>
+struct Avx512<float>
+{
+  using reg                     = __m512;
+  static constexpr size_t width = 16;
+
+  BSPLINEX_SIMD_AVX512 reg load(float const *p) { return _mm512_loadu_ps(p); }
+  BSPLINEX_SIMD_AVX512 void store(float *p, reg a) { _mm512_storeu_ps(p, a); }
+  BSPLINEX_SIMD_AVX512 reg set1(float a) { return _mm512_set1_ps(a); }
+  BSPLINEX_SIMD_AVX512 reg add(reg a, reg b) { return _mm512_add_ps(a, b); }
+  BSPLINEX_SIMD_AVX512 reg sub(reg a, reg b) { return _mm512_sub_ps(a, b); }
+  BSPLINEX_SIMD_AVX512 reg mul(reg a, reg b) { return _mm512_mul_ps(a, b); }
+  BSPLINEX_SIMD_AVX512 reg div(reg a, reg b) { return _mm512_div_ps(a, b); }
+
+  BSPLINEX_SIMD_AVX512 reg gather(float const *base, int32_t const *idx, int32_t offset)
+  {
+    __m512i i = _mm512_add_epi32(_mm512_load_si512(idx), _mm512_set1_epi32(offset));
+    return _mm512_i32gather_ps(i, base, 4);
+  }
+
+  BSPLINEX_SIMD_AVX512 bool in_range(reg x, reg lo, reg hi)
+  {
+    return (_mm512_cmp_ps_mask(x, lo, _CMP_GE_OQ) & _mm512_cmp_ps_mask(x, hi, _CMP_LT_OQ)) ==
+           0xFFFF;
+  }
+
+  BSPLINEX_SIMD_AVX512 void to_index(reg scaled, int32_t add, int32_t last, int32_t *out)
+  {
+    __m512i i = _mm512_add_epi32(_mm512_cvttps_epi32(scaled), _mm512_set1_epi32(add));
+    _mm512_storeu_si512(out, _mm512_min_epi32(i, _mm512_set1_epi32(last)));
+  }
+};
+
+#define BSPLINEX_SIMD_NAMESPACE sse
+#define BSPLINEX_SIMD_TARGET __attribute__((target("sse4.1")))
+#include "BSplineX/simd/simd_kernels.hpp"
+#undef BSPLINEX_SIMD_TARGET
+#undef BSPLINEX_SIMD_NAMESPACE
+
+#define BSPLINEX_SIMD_NAMESPACE avx2
+#define BSPLINEX_SIMD_TARGET __attribute__((target("avx2")))
+#include "BSplineX/simd/simd_kernels.hpp"
+#undef BSPLINEX_SIMD_TARGET
+#undef BSPLINEX_SIMD_NAMESPACE
+
+#define BSPLINEX_SIMD_NAMESPACE avx512
+#define BSPLINEX_SIMD_TARGET __attribute__((target("avx512f")))
+#include "BSplineX/simd/simd_kernels.hpp"
+#undef BSPLINEX_SIMD_TARGET
+#undef BSPLINEX_SIMD_NAMESPACE
+
+#endif
+
+template <typename T>
+constexpr bool has_simd = std::is_same_v<T, float> || std::is_same_v<T, double>;
+
+/**
+ * Batched de Boor with the kernel for `isa` (already resolved, see `resolve_isa`). Returns false
+ * without touching `results` when there is no vectorised kernel for this case, the caller then runs
+ * the scalar one. `size` is the number of padded knots, which must fit the 32 bit gather offsets.
+ */
+template <typename T, typename Degree, typename ControlPoints>
+bool deboor(
+    [[maybe_unused]] Isa isa,
+    [[maybe_unused]] Degree degree,
+    [[maybe_unused]] T const *knots,
+    [[maybe_unused]] size_t size,
+    [[maybe_unused]] ControlPoints const &control_points,
+    [[maybe_unused]] size_t const *indices,
+    [[maybe_unused]] T const *values,
+    [[maybe_unused]] size_t count,
+    [[maybe_unused]] T *results
+)
+{
+#ifdef BSPLINEX_SIMD_X86
+  if constexpr (has_simd<T>)
+  {
+    if (degree > STACK_MAX_DEGREE ||
+        size > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+      return false;
+    }
+
+    switch (isa)
+    {
+    case Isa::AVX512:
+      avx512::deboor<Avx512<T>>(degree, knots, control_points, indices, values, count, results);
+      return true;
+    case Isa::AVX2:
+      avx2::deboor<Avx2<T>>(degree, knots, control_points, indices, values, count, results);
+      return true;
+    case Isa::SSE:
+      sse::deboor<Sse<T>>(degree, knots, control_points, indices, values, count, results);
+      return true;
+    default:
+      return false;
+    }
+  }
+#endif
+  return false;
+}
+
+/**
+ * Knot intervals of `count` values on uniform knots, `[left, right[` being the domain and
+ * `index_last` the last interval. Returns false if there is no vectorised kernel or if any value
+ * needs extrapolating, the caller then locates the batch with `knots::Knots::find`.
+ */
+template <typename T>
+bool find_uniform(
+    [[maybe_unused]] Isa isa,
+    [[maybe_unused]] T const *values,
+    [[maybe_unused]] size_t count,
+    [[maybe_unused]] T left,
+    [[maybe_unused]] T right,
+    [[maybe_unused]] T step_size_inv,
+    [[maybe_unused]] size_t degree,
+    [[maybe_unused]] size_t index_last,
+    [[maybe_unused]] size_t *indices
+)
+{
+#ifdef BSPLINEX_SIMD_X86
+  if constexpr (has_simd<T>)
+  {
+    if (index_last > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    {
+      return false;
+    }
+
+    int32_t p    = static_cast<int32_t>(degree);
+    int32_t last = static_cast<int32_t>(index_last);
+    switch (isa)
+    {
+    case Isa::AVX512:
+      return avx512::find_uniform<Avx512<T>>(
+          values, count, left, right, step_size_inv, p, last, indices
+      );
+    case Isa::AVX2:
+      return avx2::find_uniform<Avx2<T>>(
+          values, count, left, right, step_size_inv, p, last, indices
+      );
+    case Isa::SSE:
+      return sse::find_uniform<Sse<T>>(values, count, left, right, step_size_inv, p, last, indices);
+    default:
+      return false;
+    }
+  }
+#endif
+  return false;
+}
+
+} // namespace bsplinex::simd
+
+#endif
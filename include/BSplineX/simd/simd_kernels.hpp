@@ -0,0 +1,120 @@
+// No include guard: this file is included once per instruction set by `simd.hpp`, which defines
+// `BSPLINEX_SIMD_NAMESPACE` and `BSPLINEX_SIMD_TARGET` beforehand. The kernels are written once
+// against the `Vec` interface of `simd.hpp` and compiled for every target this way, since a
+// function can only be compiled for the instruction set named in its own `target` attribute.
+// It is included from within `namespace bsplinex::simd`.
+
+namespace BSPLINEX_SIMD_NAMESPACE
+{
+
+// Same as `deboor::deboor` on a batch, `V::width` points at a time with gathered knots and control
+// points. The remaining points go through the scalar recurrence.
+template <typename V, typename T, typename Degree, typename ControlPoints>
+BSPLINEX_SIMD_TARGET void deboor(
+    Degree degree,
+    T const *knots,
+    ControlPoints const &control_points,
+    size_t const *indices,
+    T const *values,
+    size_t count,
+    T *results
+)
+{
+  using reg = typename V::reg;
+
+  alignas(64) int32_t idx[V::width];
+  reg support[STACK_MAX_DEGREE + 1];
+  int32_t const p = static_cast<int32_t>(degree);
+  T const *points = control_points.data();
+
+  size_t l{0};
+  for (; l + V::width <= count; l += V::width)
+  {
+    for (size_t k{0}; k < V::width; k++)
+    {
+      idx[k] = static_cast<int32_t>(indices[l + k]);
+    }
+    reg x   = V::load(values + l);
+    reg one = V::set1((T)1);
+
+    for (size_t j = 0; j <= degree; j++)
+    {
+      support[j] = V::gather(points, idx, static_cast<int32_t>(j) - p);
+    }
+
+    for (size_t r = 1; r <= degree; r++)
+    {
+      for (size_t j = degree; j >= r; j--)
+      {
+        reg left   = V::gather(knots, idx, static_cast<int32_t>(j) - p);
+        reg right  = V::gather(knots, idx, static_cast<int32_t>(j + 1 - r));
+        reg alpha  = V::div(V::sub(x, left), V::sub(right, left));
+        support[j] = V::add(V::mul(V::sub(one, alpha), support[j - 1]), V::mul(alpha, support[j]));
+      }
+    }
+
+    V::store(results + l, support[degree]);
+  }
+
+  T scalar_support[STACK_MAX_DEGREE + 1];
+  for (; l < count; l++)
+  {
+    results[l] = bsplinex::deboor::deboor(
+        degree, scalar_support, knots, control_points, indices[l], values[l]
+    );
+  }
+}
+
+// Knot intervals of uniform knots, same formula as `knots::Finder<T, Curve::UNIFORM, ...>::find`.
+// Returns false, leaving `indices` partially written, as soon as a value falls outside of
+// `[left, right[` and needs extrapolating.
+template <typename V, typename T>
+BSPLINEX_SIMD_TARGET bool find_uniform(
+    T const *values,
+    size_t count,
+    T left,
+    T right,
+    T step_size_inv,
+    int32_t degree,
+    int32_t index_last,
+    size_t *indices
+)
+{
+  using reg = typename V::reg;
+
+  alignas(64) int32_t idx[V::width];
+  reg left_v  = V::set1(left);
+  reg right_v = V::set1(right);
+  reg inv_v   = V::set1(step_size_inv);
+
+  size_t l{0};
+  for (; l + V::width <= count; l += V::width)
+  {
+    reg x = V::load(values + l);
+    if (!V::in_range(x, left_v, right_v))
+    {
+      return false;
+    }
+    V::to_index(V::mul(V::sub(x, left_v), inv_v), degree, index_last, idx);
+    for (size_t k{0}; k < V::width; k++)
+    {
+      indices[l + k] = static_cast<size_t>(idx[k]);
+    }
+  }
+
+  for (; l < count; l++)
+  {
+    if (values[l] < left || values[l] >= right)
+    {
+      return false;
+    }
+    indices[l] = std::min(
+        static_cast<size_t>((values[l] - left) * step_size_inv) + static_cast<size_t>(degree),
+        static_cast<size_t>(index_last)
+    );
+  }
+
+  return true;
+}
+
+} // namespace BSPLINEX_SIMD_NAMESPACE
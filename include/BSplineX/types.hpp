@@ -24,6 +24,37 @@ enum class Extrapolation
   NONE     = 2
 };
 
+enum class Search
+{
+  AUTO       = 0,
+  BINARY     = 1,
+  BRANCHLESS = 2,
+  EYTZINGER  = 3,
+  LINEAR     = 4,
+  BUCKET     = 5
+};
+
+enum class Penalty
+{
+  DIFFERENCE = 0,
+  DERIVATIVE = 1
+};
+
+enum class Smoothing
+{
+  GCV  = 0,
+  REML = 1
+};
+
+enum class Isa
+{
+  AUTO   = 0,
+  SCALAR = 1,
+  SSE    = 2,
+  AVX2   = 3,
+  AVX512 = 4
+};
+
 } // namespace bsplinex
 
 #endif
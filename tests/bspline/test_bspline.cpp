@@ -1,6 +1,8 @@
 // Third-party includes
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <cmath>
+#include <numeric>
 #include <random>
 
 // BSplineX includes
@@ -46,6 +48,63 @@ TEST_CASE(
     }
   }
 
+  SECTION("bspline.evaluate(std::vector<T>)")
+  {
+    std::vector<double> results = bspline.evaluate(x_values);
+    REQUIRE(results.size() == x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(i), WithinRel(y_values.at(i)));
+    }
+  }
+
+  SECTION("bspline.evaluate_ordered(std::vector<T>)")
+  {
+    std::vector<double> results = bspline.evaluate_ordered(x_values);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(i), WithinRel(y_values.at(i)));
+    }
+
+    // Unsorted values fall back to a search
+    std::vector<double> reversed{x_values.rbegin(), x_values.rend()};
+    results = bspline.evaluate_ordered(reversed);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(x_values.size() - 1 - i), WithinRel(y_values.at(i)));
+    }
+  }
+
+  SECTION("bspline.evaluate_parallel(std::vector<T>, num_threads)")
+  {
+    // Enough values for several chunks
+    std::vector<double> many_x_values{};
+    for (size_t k{0}; k < 100; k++)
+    {
+      many_x_values.insert(many_x_values.end(), x_values.begin(), x_values.end());
+    }
+    std::vector<double> expected = bspline.evaluate(many_x_values);
+
+    for (size_t num_threads : {0, 1, 2, 4})
+    {
+      std::vector<double> results = bspline.evaluate_parallel(many_x_values, num_threads);
+      REQUIRE(results == expected);
+    }
+
+    many_x_values.at(many_x_values.size() / 2) = 100.0;
+    REQUIRE_THROWS_AS(bspline.evaluate_parallel(many_x_values, 4), std::runtime_error);
+  }
+
+  SECTION("bspline.evaluate(...) const")
+  {
+    auto const &const_bspline = bspline;
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(const_bspline.evaluate(x_values.at(i)), WithinRel(y_values.at(i)));
+      REQUIRE(const_bspline.basis(x_values.at(i)).size() == c_data.size());
+    }
+  }
+
   SECTION("bspline.compute_basis(...)")
   {
     for (size_t i{0}; i < x_values.size(); i++)
@@ -61,6 +120,39 @@ TEST_CASE(
     }
   }
 
+  SECTION("bspline.basis(value, nnz)")
+  {
+    std::vector<double> nnz(degree + 1, -1.0);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      std::vector<double> dense = bspline.basis(x_values.at(i));
+      size_t index              = bspline.basis(x_values.at(i), nnz.begin());
+      REQUIRE(index + degree < c_data.size());
+      for (size_t j{0}; j < dense.size(); j++)
+      {
+        double expected = j >= index && j <= index + degree ? nnz.at(j - index) : 0.0;
+        REQUIRE(dense.at(j) == expected);
+      }
+    }
+  }
+
+  SECTION("bspline.basis(values, num_values, indices, nnz)")
+  {
+    std::vector<size_t> indices(x_values.size());
+    std::vector<double> nnz(x_values.size() * (degree + 1));
+    bspline.basis(x_values.data(), x_values.size(), indices.data(), nnz.data());
+
+    std::vector<double> single(degree + 1);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE(indices.at(i) == bspline.basis(x_values.at(i), single.begin()));
+      for (size_t j{0}; j <= degree; j++)
+      {
+        REQUIRE(nnz.at(i * (degree + 1) + j) == single.at(j));
+      }
+    }
+  }
+
   SECTION("bspline.fit(...) dense")
   {
     bspline.fit(x_values, y_values);
@@ -157,6 +249,165 @@ TEST_CASE(
       REQUIRE_THAT(big_bspline.evaluate(big_x.at(i)), WithinRel(big_y.at(i), 1e-6));
     }
   }
+
+  SECTION("bspline.fit(...) noisy data matches the general QR")
+  {
+    std::mt19937 rng{42};
+    std::normal_distribution noise{0.0, 0.1};
+    std::uniform_real_distribution unif{2.2, 6.3};
+
+    std::vector<double> noisy_x(2000);
+    std::vector<double> noisy_y(noisy_x.size());
+    for (size_t i{0}; i < noisy_x.size(); i++)
+    {
+      noisy_x.at(i) = unif(rng);
+      noisy_y.at(i) = std::sin(noisy_x.at(i)) + noise(rng);
+    }
+
+    Eigen::MatrixXd A = bspline.design_matrix(noisy_x).map().toDense();
+    Eigen::Map<Eigen::VectorXd> b(noisy_y.data(), noisy_y.size());
+    Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+
+    bspline.fit(noisy_x, noisy_y);
+    auto const &control_points = bspline.get_control_points();
+    for (size_t i{0}; i < c_data.size(); i++)
+    {
+      REQUIRE_THAT(control_points.at(i), WithinAbs(expected(i), 1e-9));
+    }
+  }
+
+  SECTION("bspline.fit(x, y, num_threads)")
+  {
+    std::mt19937 rng{7};
+    std::normal_distribution noise{0.0, 0.1};
+    std::uniform_real_distribution unif{2.2, 6.3};
+
+    std::vector<double> noisy_x(5 * FIT_CHUNK_SIZE + 3);
+    std::vector<double> noisy_y(noisy_x.size());
+    for (size_t i{0}; i < noisy_x.size(); i++)
+    {
+      noisy_x.at(i) = unif(rng);
+      noisy_y.at(i) = std::cos(noisy_x.at(i)) + noise(rng);
+    }
+
+    bspline.fit(noisy_x, noisy_y);
+    std::vector<double> serial{};
+    for (size_t i{0}; i < c_data.size(); i++)
+    {
+      serial.push_back(bspline.get_control_points().at(i));
+    }
+
+    for (size_t num_threads : {0, 2, 4, 9})
+    {
+      bspline.fit(noisy_x, noisy_y, num_threads);
+      std::vector<double> first_run{};
+      for (size_t i{0}; i < c_data.size(); i++)
+      {
+        first_run.push_back(bspline.get_control_points().at(i));
+        REQUIRE_THAT(first_run.at(i), WithinAbs(serial.at(i), 1e-10));
+      }
+
+      // Same number of threads, same bits
+      bspline.fit(noisy_x, noisy_y, num_threads);
+      for (size_t i{0}; i < c_data.size(); i++)
+      {
+        REQUIRE(bspline.get_control_points().at(i) == first_run.at(i));
+      }
+    }
+  }
+
+  SECTION("bspline.fit(x, y, w)")
+  {
+    std::mt19937 rng{3};
+    std::normal_distribution noise{0.0, 0.1};
+    std::uniform_real_distribution unif{2.2, 6.3};
+
+    // Integer weights count as repeated samples, zero weights drop them
+    std::vector<double> noisy_x(2000);
+    std::vector<double> noisy_y(noisy_x.size());
+    std::vector<double> weights(noisy_x.size());
+    std::vector<double> repeated_x{};
+    std::vector<double> repeated_y{};
+    for (size_t i{0}; i < noisy_x.size(); i++)
+    {
+      noisy_x.at(i) = unif(rng);
+      noisy_y.at(i) = std::sin(noisy_x.at(i)) + noise(rng);
+      weights.at(i) = (double)(i % 4);
+      for (size_t k{0}; k < i % 4; k++)
+      {
+        repeated_x.push_back(noisy_x.at(i));
+        repeated_y.push_back(noisy_y.at(i));
+      }
+    }
+
+    bspline.fit(repeated_x, repeated_y);
+    std::vector<double> expected{};
+    for (size_t i{0}; i < c_data.size(); i++)
+    {
+      expected.push_back(bspline.get_control_points().at(i));
+    }
+
+    for (size_t num_threads : {1, 3})
+    {
+      bspline.fit(noisy_x, noisy_y, weights, num_threads);
+      for (size_t i{0}; i < c_data.size(); i++)
+      {
+        REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(expected.at(i), 1e-10));
+      }
+    }
+
+    REQUIRE_THROWS_AS(
+        bspline.fit(noisy_x, noisy_y, std::vector<double>(3, 1.0)), std::runtime_error
+    );
+    weights.at(5) = -1.0;
+    REQUIRE_THROWS_AS(bspline.fit(noisy_x, noisy_y, weights), std::runtime_error);
+  }
+
+  SECTION("bspline.interpolate(x, y)")
+  {
+    // One sample per control point, spread over the supports and given in no particular order
+    std::vector<double> interp_x{5.5, 2.3, 6.2, 4.0, 3.0};
+    std::vector<double> interp_y(interp_x.size());
+    for (size_t i{0}; i < interp_x.size(); i++)
+    {
+      interp_y.at(i) = bspline.evaluate(interp_x.at(i));
+    }
+
+    bspline.interpolate(interp_x, interp_y);
+    for (size_t i{0}; i < c_data.size(); i++)
+    {
+      REQUIRE_THAT(bspline.get_control_points().at(i), WithinRel(c_data.at(i), 1e-10));
+    }
+
+    // Two coinciding samples leave a control point undetermined
+    interp_x.at(1) = 3.0;
+    REQUIRE_THROWS_AS(bspline.interpolate(interp_x, interp_y), std::runtime_error);
+    REQUIRE_THROWS_AS(bspline.interpolate({2.3, 3.0}, {1.0, 2.0}), std::runtime_error);
+  }
+
+  SECTION("bspline.fit(...) knot intervals without data")
+  {
+    // No sample in [2.2, 4.9[, the normal equations are singular and the general QR takes over
+    std::vector<double> sparse_x{};
+    for (double x : x_values)
+    {
+      if (x >= 4.9)
+      {
+        sparse_x.push_back(x);
+      }
+    }
+    std::vector<double> sparse_y{};
+    for (double x : sparse_x)
+    {
+      sparse_y.push_back(bspline.evaluate(x));
+    }
+
+    bspline.fit(sparse_x, sparse_y);
+    for (size_t i{0}; i < sparse_x.size(); i++)
+    {
+      REQUIRE_THAT(bspline.evaluate(sparse_x.at(i)), WithinAbs(sparse_y.at(i), 1e-9));
+    }
+  }
 }
 
 TEST_CASE(
@@ -219,6 +470,48 @@ TEST_CASE(
       REQUIRE_THAT(bspline.evaluate(x_values.at(i)), WithinRel(y_values.at(i)));
     }
   }
+  SECTION("bspline.interpolate(...) large")
+  {
+    std::mt19937 rng{05535};
+    std::normal_distribution norm{0.0, 1.0};
+
+    size_t num_knots{2000};
+    std::vector<double> big_ctrl_pts(num_knots + degree - 1);
+    std::generate(big_ctrl_pts.begin(), big_ctrl_pts.end(), [&norm, &rng]() { return norm(rng); });
+    types::ClampedUniform<double> big_bspline{
+        {0.0, (double)(num_knots - 1), num_knots}, {big_ctrl_pts}, degree
+    };
+
+    // Samples at the Greville abscissae, the averages of the inner knots of each support, with the
+    // last one moved inside the right-open domain
+    std::vector<double> padded(degree, 0.0);
+    for (size_t i{0}; i < num_knots; i++)
+    {
+      padded.push_back((double)i);
+    }
+    padded.insert(padded.end(), degree, (double)(num_knots - 1));
+    std::vector<double> big_x(big_ctrl_pts.size());
+    std::vector<double> big_y(big_x.size());
+    for (size_t i{0}; i < big_x.size(); i++)
+    {
+      big_x.at(i) = std::accumulate(padded.begin() + i + 1, padded.begin() + i + degree + 1, 0.0) /
+                    (double)degree;
+      big_x.at(i) = std::min(big_x.at(i), std::nextafter(padded.back(), 0.0));
+      big_y.at(i) = big_bspline.evaluate(big_x.at(i));
+    }
+
+    // Both entry points go through the banded collocation solve
+    big_bspline.interpolate(big_x, big_y);
+    for (size_t i{0}; i < big_ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(big_bspline.get_control_points().at(i), WithinAbs(big_ctrl_pts.at(i), 1e-9));
+    }
+    big_bspline.fit(big_x, big_y);
+    for (size_t i{0}; i < big_ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(big_bspline.get_control_points().at(i), WithinAbs(big_ctrl_pts.at(i), 1e-9));
+    }
+  }
 }
 
 TEST_CASE(
@@ -251,6 +544,33 @@ TEST_CASE(
       REQUIRE_THAT(bspline.evaluate(x_values.at(i)), WithinRel(y_values.at(i)));
     }
   }
+
+  SECTION("bspline.fit(...) out of the domain matches the general QR")
+  {
+    // Samples past both ends are clamped to the domain, as when evaluating
+    std::mt19937 rng{42};
+    std::normal_distribution noise{0.0, 0.1};
+    std::uniform_real_distribution unif{-3.0, 16.0};
+
+    std::vector<double> noisy_x(2000);
+    std::vector<double> noisy_y(noisy_x.size());
+    for (size_t i{0}; i < noisy_x.size(); i++)
+    {
+      noisy_x.at(i) = unif(rng);
+      noisy_y.at(i) = std::sin(0.5 * noisy_x.at(i)) + noise(rng);
+    }
+
+    Eigen::MatrixXd A = bspline.design_matrix(noisy_x).map().toDense();
+    Eigen::Map<Eigen::VectorXd> b(noisy_y.data(), noisy_y.size());
+    Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+
+    bspline.fit(noisy_x, noisy_y);
+    auto const &control_points = bspline.get_control_points();
+    for (size_t i{0}; i < c_data.size(); i++)
+    {
+      REQUIRE_THAT(control_points.at(i), WithinAbs(expected(i), 1e-9));
+    }
+  }
 }
 
 TEST_CASE(
@@ -322,6 +642,33 @@ TEST_CASE(
     }
   }
 
+  SECTION("bspline.evaluate(std::vector<T>)")
+  {
+    std::vector<double> results = bspline.evaluate(x_values);
+    REQUIRE(results.size() == x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(i), WithinRel(y_values.at(i)));
+    }
+  }
+
+  SECTION("bspline.evaluate_ordered(std::vector<T>)")
+  {
+    std::vector<double> results = bspline.evaluate_ordered(x_values);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(i), WithinRel(y_values.at(i)));
+    }
+
+    // Unsorted values fall back to a search
+    std::vector<double> reversed{x_values.rbegin(), x_values.rend()};
+    results = bspline.evaluate_ordered(reversed);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      REQUIRE_THAT(results.at(x_values.size() - 1 - i), WithinRel(y_values.at(i)));
+    }
+  }
+
   SECTION("bspline.fit(...)")
   {
     bspline.fit(x_values, y_values);
@@ -336,4 +683,98 @@ TEST_CASE(
       REQUIRE_THAT(control_points.at(i + j), WithinRel(c_data.at(j), 1e-6));
     }
   }
+  SECTION("bspline.fit(x, y, w)")
+  {
+    // Through the general QR, weights scale the rows by their square roots
+    std::vector<double> weights(x_values.size());
+    std::vector<double> repeated_x{};
+    std::vector<double> repeated_y{};
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      weights.at(i) = (double)(i % 3 + 1);
+      for (size_t k{0}; k <= i % 3; k++)
+      {
+        repeated_x.push_back(x_values.at(i));
+        repeated_y.push_back(y_values.at(i) + 0.01 * (double)k);
+      }
+    }
+    std::vector<double> weighted_y(x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      // The mean of the repeated values
+      weighted_y.at(i) = y_values.at(i) + 0.01 * (double)(i % 3) / 2.0;
+    }
+
+    bspline.fit(repeated_x, repeated_y);
+    std::vector<double> expected{};
+    for (size_t i{0}; i < bspline.get_control_points().size(); i++)
+    {
+      expected.push_back(bspline.get_control_points().at(i));
+    }
+
+    bspline.fit(x_values, weighted_y, weights);
+    for (size_t i{0}; i < expected.size(); i++)
+    {
+      REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(expected.at(i), 1e-9));
+    }
+  }
+
+  SECTION("bspline.fit(...) noisy data matches the general QR")
+  {
+    // Samples over several periods, wrapped into the domain by the extrapolation
+    std::mt19937 rng{42};
+    std::normal_distribution noise{0.0, 0.1};
+    std::uniform_real_distribution unif{-20.0, 30.0};
+
+    std::vector<double> noisy_x(2000);
+    std::vector<double> noisy_y(noisy_x.size());
+    for (size_t i{0}; i < noisy_x.size(); i++)
+    {
+      noisy_x.at(i) = unif(rng);
+      noisy_y.at(i) = std::sin(noisy_x.at(i)) + noise(rng);
+    }
+
+    Eigen::MatrixXd A = bspline.design_matrix(noisy_x).map().toDense();
+    Eigen::Map<Eigen::VectorXd> b(noisy_y.data(), noisy_y.size());
+    Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+
+    for (size_t num_threads : {1, 3})
+    {
+      bspline.fit(noisy_x, noisy_y, num_threads);
+      auto const &control_points = bspline.get_control_points();
+      for (size_t i{0}; i < c_data.size(); i++)
+      {
+        REQUIRE_THAT(control_points.at(i), WithinAbs(expected(i), 1e-9));
+      }
+      for (size_t j{0}; j < degree; j++)
+      {
+        REQUIRE_THAT(control_points.at(c_data.size() + j), WithinAbs(expected(j), 1e-9));
+      }
+    }
+  }
+
+  SECTION("bspline.interpolate(x, y)")
+  {
+    // The last samples wrap around the first control points
+    std::vector<double> interp_x{11.0, 0.5, 8.0, 1.0, 3.0, 1.8, 5.5, 4.0};
+    std::vector<double> interp_y(interp_x.size());
+    for (size_t i{0}; i < interp_x.size(); i++)
+    {
+      interp_y.at(i) = bspline.evaluate(interp_x.at(i));
+    }
+
+    bspline.interpolate(interp_x, interp_y);
+    auto control_points = bspline.get_control_points();
+    size_t i{0};
+    for (; i < c_data.size(); i++)
+    {
+      REQUIRE_THAT(control_points.at(i), WithinRel(c_data.at(i), 1e-10));
+    }
+    for (size_t j{0}; j < degree; j++)
+    {
+      REQUIRE_THAT(control_points.at(i + j), WithinRel(c_data.at(j), 1e-10));
+    }
+
+    REQUIRE_THROWS_AS(bspline.interpolate(x_values, y_values), std::runtime_error);
+  }
 }
@@ -0,0 +1,198 @@
+// Standard includes
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Dense>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_circulant.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::CirculantFit<T, C, BC, EXT> circulant{bspline, x}", "[bspline]")
+{
+  size_t degree{3};
+  size_t num_cols{25};
+  double const period{(double)num_cols};
+
+  std::mt19937 rng{42};
+  std::normal_distribution<double> norm{0.0, 1.0};
+  std::vector<double> ctrl_pts(num_cols);
+  for (auto &c : ctrl_pts)
+  {
+    c = norm(rng);
+  }
+  types::PeriodicUniform<double> bspline{{0.0, period, num_cols + 1}, {ctrl_pts}, degree};
+  types::PeriodicUniform<double> reference{bspline};
+
+  // `samples_per_interval` points per knot interval over one period, from `first`
+  auto grid = [&](double first, size_t samples_per_interval)
+  {
+    std::vector<double> x(num_cols * samples_per_interval);
+    for (size_t i{0}; i < x.size(); i++)
+    {
+      x.at(i) = first + (double)i * period / (double)x.size();
+    }
+    return x;
+  };
+
+  SECTION("circulant.fit(y) interpolates")
+  {
+    // Starting outside of the domain, the periodic extrapolation wraps the samples
+    std::vector<double> x_values = grid(-7.3, 1);
+    std::vector<double> y_values(x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      y_values.at(i) = bspline.evaluate(x_values.at(i));
+    }
+
+    CirculantFit circulant{bspline, x_values};
+    REQUIRE(circulant.size() == x_values.size());
+    REQUIRE(circulant.is_valid());
+    circulant.fit(y_values);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(ctrl_pts.at(i), 1e-10));
+    }
+
+    // bspline.fit detects the grid on its own
+    reference.fit(x_values, y_values);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(reference.get_control_points().at(i), WithinAbs(ctrl_pts.at(i), 1e-10));
+    }
+  }
+
+  SECTION("circulant.fit(y) matches the general QR")
+  {
+    std::vector<double> x_values = grid(0.1, 3);
+    std::vector<double> y_values(x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      y_values.at(i) = std::sin(x_values.at(i)) + 0.1 * norm(rng);
+    }
+
+    Eigen::MatrixXd A = bspline.design_matrix(x_values).map().toDense();
+    Eigen::Map<Eigen::VectorXd> b(y_values.data(), y_values.size());
+    Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+
+    CirculantFit circulant{bspline, x_values};
+    circulant.fit(y_values);
+    reference.fit(x_values, y_values);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(expected(i), 1e-10));
+      REQUIRE_THAT(reference.get_control_points().at(i), WithinAbs(expected(i), 1e-10));
+    }
+  }
+
+  SECTION("circulant.fit(y, lambda) penalizes cyclic differences")
+  {
+    std::vector<double> x_values = grid(0.0, 2);
+    std::vector<double> y_values(x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      y_values.at(i) = std::cos(x_values.at(i)) + 0.1 * norm(rng);
+    }
+
+    size_t order{2};
+    Eigen::MatrixXd D = Eigen::MatrixXd::Zero(num_cols, num_cols);
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      D(k, k)                      = 1.0;
+      D(k, (k + 1) % num_cols)     = -2.0;
+      D(k, (k + order) % num_cols) = 1.0;
+    }
+    Eigen::MatrixXd A = bspline.design_matrix(x_values).map().toDense();
+    Eigen::Map<Eigen::VectorXd> b(y_values.data(), y_values.size());
+
+    CirculantFit circulant{bspline, x_values, order};
+    for (double lambda : {0.01, 1.0, 100.0})
+    {
+      Eigen::MatrixXd system   = A.transpose() * A + lambda * D.transpose() * D;
+      Eigen::VectorXd expected = system.llt().solve(A.transpose() * b);
+      circulant.fit(y_values, lambda);
+      for (size_t i{0}; i < num_cols; i++)
+      {
+        REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(expected(i), 1e-10));
+      }
+    }
+    REQUIRE_THROWS_AS(circulant.fit(y_values, -1.0), std::runtime_error);
+  }
+
+  SECTION("samples off the grid")
+  {
+    std::vector<double> x_values = grid(0.0, 2);
+    REQUIRE(bspline.circulant(x_values).has_value());
+
+    x_values.at(7) += 1e-3;
+    REQUIRE_FALSE(bspline.circulant(x_values).has_value());
+    REQUIRE_THROWS_AS(CirculantFit(bspline, x_values), std::runtime_error);
+
+    // Not a whole number of samples per knot interval
+    x_values.pop_back();
+    REQUIRE_FALSE(bspline.circulant(x_values).has_value());
+  }
+
+  SECTION("samples out of the domain without periodic extrapolation")
+  {
+    // A grid over [4, 12[ on the domain [0, 8[
+    using NonPeriodic =
+        BSpline<double, Curve::UNIFORM, BoundaryCondition::PERIODIC, Extrapolation::NONE>;
+    NonPeriodic none{{0.0, 8.0, (size_t)9}, {std::vector<double>(8)}, degree};
+    std::vector<double> x_values(32);
+    std::vector<double> y_values(32);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      x_values.at(i) = 4.0 + (double)i * 0.25;
+      y_values.at(i) = std::sin(x_values.at(i));
+    }
+    REQUIRE_FALSE(none.circulant(x_values).has_value());
+    REQUIRE_THROWS_AS(CirculantFit(none, x_values), std::runtime_error);
+    REQUIRE_THROWS_AS(none.fit(x_values, y_values), std::runtime_error);
+
+    // The same grid moved into the domain takes the FFT path, for any extrapolation
+    using Constant =
+        BSpline<double, Curve::UNIFORM, BoundaryCondition::PERIODIC, Extrapolation::CONSTANT>;
+    Constant constant{{0.0, 8.0, (size_t)9}, {std::vector<double>(8)}, degree};
+    REQUIRE_FALSE(constant.circulant(x_values).has_value());
+    for (auto &x : x_values)
+    {
+      x -= 4.0;
+    }
+    REQUIRE(none.circulant(x_values).has_value());
+    REQUIRE(constant.circulant(x_values).has_value());
+  }
+
+  SECTION("singular systems are reported")
+  {
+    // Cubic interpolation at the midpoints cannot resolve the highest frequency of an even number
+    // of control points
+    types::PeriodicUniform<double> even{{0.0, 24.0, (size_t)25}, {std::vector<double>(24)}, degree};
+    std::vector<double> x_values(24);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      x_values.at(i) = (double)i + 0.5;
+    }
+    CirculantFit circulant{even, x_values};
+    REQUIRE_THROWS_AS(circulant.fit(std::vector<double>(24, 1.0)), std::runtime_error);
+    REQUIRE_NOTHROW(circulant.fit(std::vector<double>(24, 1.0), 1e-3));
+  }
+
+  SECTION("circulant.is_valid()")
+  {
+    std::vector<double> x_values = grid(0.0, 1);
+    CirculantFit circulant{bspline, x_values};
+    bspline = types::PeriodicUniform<double>{{0.0, 2.0 * period, num_cols + 1}, {ctrl_pts}, degree};
+    REQUIRE_FALSE(circulant.is_valid());
+    REQUIRE_THROWS_AS(circulant.fit(std::vector<double>(num_cols, 0.0)), std::runtime_error);
+  }
+}
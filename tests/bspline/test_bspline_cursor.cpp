@@ -0,0 +1,42 @@
+// Standard includes
+#include <cmath>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_cursor.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::Cursor<T, C, BC, EXT> cursor{bspline}", "[bspline]")
+{
+  std::vector<double> t_data_vec{0.1, 1.3, 2.2, 2.2, 4.9, 6.3, 6.3, 6.3, 13.2};
+  std::vector<double> c_data_vec{0.1, 1.3, 2.2, 3.2, 4.3, 5.6, 0.3, 13.2};
+  types::PeriodicNonUniform<double> bspline{{t_data_vec}, {c_data_vec}, 3};
+
+  Cursor cursor{bspline};
+
+  SECTION("cursor.evaluate(...) forward")
+  {
+    for (double x{-20.0}; x < 30.0; x += 0.01)
+    {
+      REQUIRE_THAT(cursor.evaluate(x), WithinRel(bspline.evaluate(x)));
+      REQUIRE(cursor.get_index() == bspline.get_knots().find(x).first);
+    }
+  }
+
+  SECTION("cursor.evaluate(...) jittering")
+  {
+    for (size_t i{0}; i < 2000; i++)
+    {
+      double x = 0.005 * (double)i + 0.3 * std::sin((double)i);
+      REQUIRE_THAT(cursor.evaluate(x), WithinRel(bspline.evaluate(x)));
+    }
+  }
+}
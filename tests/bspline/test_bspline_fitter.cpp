@@ -0,0 +1,185 @@
+// Standard includes
+#include <cmath>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_fitter.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::Fitter<T, C, BC, EXT> fitter{bspline}", "[bspline]")
+{
+  size_t degree{3};
+  std::vector<double> knots{};
+  for (size_t i{0}; i < 40; i++)
+  {
+    knots.push_back((double)i + 0.3 * std::sin((double)i));
+  }
+  std::vector<double> ctrl_pts(knots.size() + degree - 1, 0.0);
+  types::ClampedNonUniform<double> bspline{{knots}, {ctrl_pts}, degree};
+  types::ClampedNonUniform<double> reference{bspline};
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{knots.front(), knots.back()};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  std::vector<double> x_values(10000);
+  std::vector<double> y_values(x_values.size());
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = unif(rng);
+    y_values.at(i) = std::cos(0.3 * x_values.at(i)) + noise(rng);
+  }
+  reference.fit(x_values, y_values);
+
+  auto require_reference = [&]()
+  {
+    for (size_t i{0}; i < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-10)
+      );
+    }
+  };
+
+  Fitter fitter{bspline};
+
+  SECTION("fitter.add(x, y, num_samples) in chunks")
+  {
+    size_t first{0};
+    for (size_t chunk : {1, 17, 0, 4000, 5982})
+    {
+      fitter.add(x_values.data() + first, y_values.data() + first, chunk);
+      first += chunk;
+    }
+    REQUIRE(fitter.size() == x_values.size());
+    fitter.finalize();
+    require_reference();
+
+    fitter.reset();
+    REQUIRE(fitter.size() == 0);
+    REQUIRE_THROWS_AS(fitter.finalize(), std::runtime_error);
+  }
+
+  SECTION("fitter.add(std::vector<T>, std::vector<T>)")
+  {
+    fitter.add(x_values, y_values);
+    fitter.finalize();
+    require_reference();
+    REQUIRE_THROWS_AS(fitter.add(x_values, std::vector<double>{}), std::runtime_error);
+  }
+
+  SECTION("fitter.add(std::vector<T>, std::vector<T>, std::vector<T>)")
+  {
+    std::vector<double> weights(x_values.size());
+    for (size_t i{0}; i < weights.size(); i++)
+    {
+      weights.at(i) = 0.5 + (double)(i % 5);
+    }
+    reference.fit(x_values, y_values, weights);
+
+    fitter.add(x_values.data(), y_values.data(), weights.data(), 1234);
+    fitter.add(
+        {x_values.begin() + 1234, x_values.end()},
+        {y_values.begin() + 1234, y_values.end()},
+        {weights.begin() + 1234, weights.end()}
+    );
+    fitter.finalize();
+    require_reference();
+    REQUIRE_THROWS_AS(fitter.add(x_values, y_values, std::vector<double>{}), std::runtime_error);
+  }
+
+  SECTION("fitter.add_file(path)")
+  {
+    std::string path = (std::filesystem::temp_directory_path() / "bsplinex_fitter.bin").string();
+    {
+      std::ofstream file{path, std::ios::binary};
+      for (size_t i{0}; i < x_values.size(); i++)
+      {
+        file.write(reinterpret_cast<char const *>(&x_values.at(i)), sizeof(double));
+        file.write(reinterpret_cast<char const *>(&y_values.at(i)), sizeof(double));
+      }
+    }
+    fitter.add_file(path);
+    REQUIRE(fitter.size() == x_values.size());
+    fitter.finalize();
+    require_reference();
+
+    {
+      std::ofstream file{path, std::ios::binary | std::ios::app};
+      file.put('\0');
+    }
+    REQUIRE_THROWS_AS(fitter.add_file(path), std::runtime_error);
+    std::remove(path.c_str());
+    REQUIRE_THROWS_AS(fitter.add_file(path), std::runtime_error);
+  }
+
+  SECTION("bspline.set_control_points(data)")
+  {
+    REQUIRE_THROWS_AS(bspline.set_control_points({1.0, 2.0}), std::runtime_error);
+  }
+}
+
+TEST_CASE("bspline::Fitter<T, C, BC, EXT> fitter{bspline} periodic", "[bspline]")
+{
+  size_t degree{3};
+  size_t num_cols{20};
+  std::vector<double> ctrl_pts(num_cols, 0.0);
+  types::PeriodicUniform<double> bspline{{0.0, 10.0, num_cols + 1}, {ctrl_pts}, degree};
+  types::PeriodicUniform<double> reference{bspline};
+
+  // Over three periods, wrapped by the extrapolation
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{-10.0, 20.0};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  std::vector<double> x_values(5000);
+  std::vector<double> y_values(x_values.size());
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = unif(rng);
+    y_values.at(i) = std::sin(0.6 * x_values.at(i)) + noise(rng);
+  }
+  reference.fit(x_values, y_values);
+
+  SECTION("fitter.add(std::vector<T>, std::vector<T>)")
+  {
+    Fitter fitter{bspline};
+    fitter.add(x_values.data(), y_values.data(), 1234);
+    fitter.add(
+        {x_values.begin() + 1234, x_values.end()}, {y_values.begin() + 1234, y_values.end()}
+    );
+    fitter.finalize();
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-10)
+      );
+    }
+  }
+
+  SECTION("bspline.normal_equations(x, y)")
+  {
+    auto const equations = bspline.normal_equations(x_values, y_values);
+    REQUIRE(equations.cols() == num_cols + degree);
+    std::vector<double> res(num_cols);
+    REQUIRE(equations.solve_periodic(res.data(), num_cols));
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(res.at(i), WithinAbs(reference.get_control_points().at(i), 1e-10));
+    }
+  }
+}
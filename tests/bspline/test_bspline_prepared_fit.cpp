@@ -0,0 +1,203 @@
+// Standard includes
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_prepared_fit.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::PreparedFit<T, C, BC, EXT> prepared{bspline, x}", "[bspline]")
+{
+  size_t degree{3};
+  std::vector<double> ctrl_pts(30 + degree - 1, 0.0);
+  types::ClampedUniform<double> bspline{{0.0, 29.0, (size_t)30}, {ctrl_pts}, degree};
+  types::ClampedUniform<double> reference{bspline};
+
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.0, 29.0};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  std::vector<double> x_values(5000);
+  for (auto &x : x_values)
+  {
+    x = unif(rng);
+  }
+
+  PreparedFit prepared{bspline, x_values};
+  REQUIRE(prepared.size() == x_values.size());
+  REQUIRE(prepared.is_valid());
+
+  SECTION("prepared.fit(y) matches bspline.fit(x, y)")
+  {
+    std::vector<double> y_values(x_values.size());
+    for (double frequency : {0.1, 0.5, 1.0})
+    {
+      for (size_t i{0}; i < x_values.size(); i++)
+      {
+        y_values.at(i) = std::sin(frequency * x_values.at(i)) + noise(rng);
+      }
+      reference.fit(x_values, y_values);
+      prepared.fit(y_values);
+      for (size_t i{0}; i < ctrl_pts.size(); i++)
+      {
+        REQUIRE_THAT(
+            bspline.get_control_points().at(i),
+            WithinAbs(reference.get_control_points().at(i), 1e-10)
+        );
+      }
+    }
+    REQUIRE_THROWS_AS(prepared.fit(std::vector<double>{1.0}), std::runtime_error);
+  }
+
+  SECTION("prepared{bspline, x, w} matches bspline.fit(x, y, w)")
+  {
+    std::vector<double> weights(x_values.size());
+    std::vector<double> y_values(x_values.size());
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      weights.at(i)  = (double)(i % 3) * 0.7;
+      y_values.at(i) = std::sin(0.5 * x_values.at(i)) + noise(rng);
+    }
+    reference.fit(x_values, y_values, weights);
+
+    PreparedFit weighted{bspline, x_values, weights};
+    weighted.fit(y_values);
+    for (size_t i{0}; i < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-10)
+      );
+    }
+
+    Eigen::MatrixXd y_matrix = Eigen::Map<Eigen::VectorXd>(y_values.data(), y_values.size());
+    Eigen::MatrixXd res      = weighted.solve(y_matrix);
+    for (size_t i{0}; i < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(res(i, 0), WithinAbs(reference.get_control_points().at(i), 1e-10));
+    }
+
+    weights.at(0) = std::nan("");
+    REQUIRE_THROWS_AS((PreparedFit{bspline, x_values, weights}), std::runtime_error);
+  }
+
+  SECTION("changing the knots invalidates the prepared fit")
+  {
+    std::vector<double> y_values(x_values.size(), 1.0);
+    bspline = types::ClampedUniform<double>{{0.0, 30.0, (size_t)30}, {ctrl_pts}, degree};
+    REQUIRE_FALSE(prepared.is_valid());
+    REQUIRE_THROWS_AS(prepared.fit(y_values), std::runtime_error);
+
+    PreparedFit again{bspline, x_values};
+    REQUIRE(again.is_valid());
+    again.fit(y_values);
+    REQUIRE_THAT(bspline.evaluate(10.0), WithinAbs(1.0, 1e-10));
+  }
+
+  SECTION("prepared.solve(y) and prepared.fit(y, bsplines) with several data sets")
+  {
+    size_t num_sets{5};
+    Eigen::MatrixXd y{x_values.size(), num_sets};
+    for (size_t q{0}; q < num_sets; q++)
+    {
+      for (size_t i{0}; i < x_values.size(); i++)
+      {
+        y(i, q) = std::sin(0.1 * (double)(q + 1) * x_values.at(i)) + noise(rng);
+      }
+    }
+
+    Eigen::MatrixXd res = prepared.solve(y);
+    REQUIRE((size_t)res.rows() == ctrl_pts.size());
+    REQUIRE((size_t)res.cols() == num_sets);
+
+    std::vector<types::ClampedUniform<double>> bsplines(num_sets, bspline);
+    prepared.fit(y, bsplines.begin());
+    for (size_t q{0}; q < num_sets; q++)
+    {
+      std::vector<double> y_q{y.col(q).data(), y.col(q).data() + y.rows()};
+      reference.fit(x_values, y_q);
+      for (size_t i{0}; i < ctrl_pts.size(); i++)
+      {
+        double expected = reference.get_control_points().at(i);
+        REQUIRE_THAT(res(i, q), WithinAbs(expected, 1e-10));
+        REQUIRE_THAT(bsplines.at(q).get_control_points().at(i), WithinAbs(expected, 1e-10));
+      }
+    }
+
+    // One B-spline with other knots, nothing is written
+    bsplines.at(0).set_control_points(ctrl_pts);
+    bsplines.at(3) = types::ClampedUniform<double>{{0.0, 30.0, (size_t)30}, {ctrl_pts}, degree};
+    REQUIRE_THROWS_AS(prepared.fit(y, bsplines.begin()), std::runtime_error);
+    REQUIRE(bsplines.at(0).get_control_points().at(5) == 0.0);
+    REQUIRE_THROWS_AS(prepared.solve(Eigen::MatrixXd{3, 2}), std::runtime_error);
+  }
+
+  SECTION("samples that do not determine the control points")
+  {
+    std::vector<double> clustered(100, 3.5);
+    REQUIRE_THROWS_AS(PreparedFit(bspline, clustered), std::runtime_error);
+  }
+}
+
+TEST_CASE("bspline::PreparedFit<T, C, BC, EXT> prepared{bspline, x} periodic", "[bspline]")
+{
+  size_t degree{3};
+  size_t num_cols{20};
+  std::vector<double> ctrl_pts(num_cols, 0.0);
+  types::PeriodicUniform<double> bspline{{0.0, 10.0, num_cols + 1}, {ctrl_pts}, degree};
+  types::PeriodicUniform<double> reference{bspline};
+
+  // Over two periods, wrapped by the extrapolation, so that rows wrap around the last columns
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{-10.0, 10.0};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  std::vector<double> x_values(3000);
+  std::vector<double> y_values(x_values.size());
+  std::vector<double> weights(x_values.size());
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = unif(rng);
+    y_values.at(i) = std::cos(0.6 * x_values.at(i)) + noise(rng);
+    weights.at(i)  = 0.5 + (double)(i % 4);
+  }
+
+  SECTION("prepared.fit(y) matches bspline.fit(x, y)")
+  {
+    PreparedFit prepared{bspline, x_values};
+    reference.fit(x_values, y_values);
+    prepared.fit(y_values);
+
+    Eigen::MatrixXd y_matrix = Eigen::Map<Eigen::VectorXd>(y_values.data(), y_values.size());
+    Eigen::MatrixXd res      = prepared.solve(y_matrix);
+    REQUIRE((size_t)res.rows() == num_cols);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      double expected = reference.get_control_points().at(i);
+      REQUIRE_THAT(bspline.get_control_points().at(i), WithinAbs(expected, 1e-10));
+      REQUIRE_THAT(res(i, 0), WithinAbs(expected, 1e-10));
+    }
+  }
+
+  SECTION("prepared{bspline, x, w} matches bspline.fit(x, y, w)")
+  {
+    PreparedFit weighted{bspline, x_values, weights};
+    reference.fit(x_values, y_values, weights);
+    weighted.fit(y_values);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-10)
+      );
+    }
+  }
+}
@@ -0,0 +1,162 @@
+// Standard includes
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_smoothing.hpp"
+#include "BSplineX/bspline/bspline_types.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::SmoothingFit<T, C, BC, EXT> smoothing{bspline, x, y}", "[bspline]")
+{
+  size_t degree{3};
+  size_t num_knots{60};
+  std::vector<double> ctrl_pts(num_knots + degree - 1, 0.0);
+  types::ClampedUniform<double> bspline{{0.0, 10.0, num_knots}, {ctrl_pts}, degree};
+  types::ClampedUniform<double> reference{bspline};
+
+  // Many knots for the noise level, plain least squares overfits
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.0, 10.0};
+  std::normal_distribution<double> noise{0.0, 0.3};
+  std::vector<double> x_values(800);
+  std::vector<double> y_values(x_values.size());
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = unif(rng);
+    y_values.at(i) = std::sin(x_values.at(i)) + noise(rng);
+  }
+
+  auto error = [&]()
+  {
+    double sum{0.0};
+    for (size_t k{0}; k < 1000; k++)
+    {
+      sum += std::pow(bspline.evaluate(0.01 * (double)k) - std::sin(0.01 * (double)k), 2);
+    }
+    return sum;
+  };
+
+  SECTION("smoothing.fit(0) is plain least squares")
+  {
+    SmoothingFit smoothing{bspline, x_values, y_values};
+    smoothing.fit(0.0);
+    reference.fit(x_values, y_values);
+    for (size_t i{0}; i < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-9)
+      );
+    }
+    REQUIRE_THAT(smoothing.effective_dof(0.0), WithinAbs((double)ctrl_pts.size(), 1e-8));
+    REQUIRE_THROWS_AS(smoothing.fit(-1.0), std::runtime_error);
+  }
+
+  SECTION("large smoothing parameters leave the null space of the penalty")
+  {
+    // Second differences of the control points vanish
+    SmoothingFit difference{bspline, x_values, y_values, Penalty::DIFFERENCE, 2};
+    difference.fit(1e10);
+    auto const &c = bspline.get_control_points();
+    for (size_t i{0}; i + 2 < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(c.at(i) - 2.0 * c.at(i + 1) + c.at(i + 2), WithinAbs(0.0, 1e-6));
+    }
+    REQUIRE_THAT(difference.effective_dof(1e10), WithinAbs(2.0, 1e-4));
+
+    // The curve itself is a straight line
+    SmoothingFit derivative{bspline, x_values, y_values, Penalty::DERIVATIVE, 2};
+    derivative.fit(1e10);
+    double slope{(bspline.evaluate(9.5) - bspline.evaluate(0.0)) / 9.5};
+    for (double x{0.0}; x < 10.0; x += 0.5)
+    {
+      REQUIRE_THAT(bspline.evaluate(x), WithinAbs(bspline.evaluate(0.0) + slope * x, 1e-5));
+    }
+  }
+
+  SECTION("smoothing.get_penalty() with Penalty::DERIVATIVE")
+  {
+    // c^T P c is the integral of s''(x)^2, 4 * 10 for s(x) = x^2 and 36 * 1000 / 3 for x^3
+    SmoothingFit smoothing{bspline, x_values, y_values, Penalty::DERIVATIVE, 2};
+    for (double power : {2.0, 3.0})
+    {
+      std::vector<double> curve(x_values.size());
+      for (size_t i{0}; i < x_values.size(); i++)
+      {
+        curve.at(i) = std::pow(x_values.at(i), power);
+      }
+      reference.fit(x_values, curve);
+      std::vector<double> c{};
+      for (size_t i{0}; i < ctrl_pts.size(); i++)
+      {
+        c.push_back(reference.get_control_points().at(i));
+      }
+      double expected{power == 2.0 ? 40.0 : 12000.0};
+      REQUIRE_THAT(smoothing.get_penalty().quadratic_form(c.data()), WithinRel(expected, 1e-9));
+    }
+  }
+
+  SECTION("smoothing.fit(Smoothing::GCV) and smoothing.fit(Smoothing::REML)")
+  {
+    reference.fit(x_values, y_values);
+    double least_squares_error{0.0};
+    for (size_t k{0}; k < 1000; k++)
+    {
+      least_squares_error +=
+          std::pow(reference.evaluate(0.01 * (double)k) - std::sin(0.01 * (double)k), 2);
+    }
+
+    for (Penalty penalty : {Penalty::DIFFERENCE, Penalty::DERIVATIVE})
+    {
+      SmoothingFit smoothing{bspline, x_values, y_values, penalty, 2};
+      for (Smoothing criterion : {Smoothing::GCV, Smoothing::REML})
+      {
+        double lambda{smoothing.fit(criterion)};
+        REQUIRE(lambda > 0.0);
+        REQUIRE(error() < 0.5 * least_squares_error);
+
+        // A minimum of the criterion
+        auto score = [&](double l)
+        { return criterion == Smoothing::GCV ? smoothing.gcv(l) : smoothing.reml(l); };
+        REQUIRE(score(lambda) <= score(0.8 * lambda));
+        REQUIRE(score(lambda) <= score(1.25 * lambda));
+
+        double dof{smoothing.effective_dof(lambda)};
+        REQUIRE(dof > 2.0);
+        REQUIRE(dof < (double)ctrl_pts.size());
+      }
+    }
+  }
+
+  SECTION("smoothing{bspline, x, y, w} matches the unweighted fit for unit weights")
+  {
+    SmoothingFit unweighted{bspline, x_values, y_values};
+    SmoothingFit weighted{bspline, x_values, y_values, std::vector<double>(x_values.size(), 1.0)};
+    for (double lambda : {1e-3, 1.0, 1e3})
+    {
+      REQUIRE_THAT(weighted.gcv(lambda), WithinRel(unweighted.gcv(lambda), 1e-10));
+      REQUIRE_THAT(weighted.reml(lambda), WithinRel(unweighted.reml(lambda), 1e-10));
+    }
+  }
+
+  SECTION("penalty orders that do not penalize anything")
+  {
+    REQUIRE_THROWS_AS(
+        (SmoothingFit{bspline, x_values, y_values, Penalty::DIFFERENCE, 0}), std::runtime_error
+    );
+    REQUIRE_THROWS_AS(
+        (SmoothingFit{bspline, x_values, y_values, Penalty::DERIVATIVE, degree + 1}),
+        std::runtime_error
+    );
+  }
+}
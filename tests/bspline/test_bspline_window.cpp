@@ -0,0 +1,165 @@
+// Standard includes
+#include <cmath>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_types.hpp"
+#include "BSplineX/bspline/bspline_window.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+TEST_CASE("bspline::WindowFitter<T, C, BC, EXT> fitter{bspline, span}", "[bspline]")
+{
+  // Domain [3, 17[, 14 knot intervals
+  size_t degree{3};
+  size_t num_knots{21};
+  std::vector<double> ctrl_pts(num_knots - degree - 1, 0.0);
+  types::OpenUniform<double> bspline{{0.0, 20.0, num_knots}, {ctrl_pts}, degree};
+
+  std::mt19937 rng{42};
+  std::normal_distribution<double> noise{0.0, 0.1};
+  std::uniform_real_distribution<double> unif{0.5, 2.0};
+  std::vector<double> x_values{};
+  std::vector<double> y_values{};
+  std::vector<double> w_values{};
+  for (double x{3.0123}; x < 60.0; x += 0.0517)
+  {
+    x_values.push_back(x);
+    y_values.push_back(std::sin(0.5 * x) + noise(rng));
+    w_values.push_back(unif(rng));
+  }
+
+  // Fits the samples up to `last` that are still in the window from scratch
+  auto require_reference = [&](auto const &fitter, size_t last, double span, bool weighted)
+  {
+    auto const [left, right] = fitter.domain();
+    std::vector<double> x_window{};
+    std::vector<double> y_window{};
+    std::vector<double> w_window{};
+    for (size_t i{0}; i <= last; i++)
+    {
+      if (x_values.at(i) >= left && x_values.at(i) >= x_values.at(last) - span)
+      {
+        x_window.push_back(x_values.at(i));
+        y_window.push_back(y_values.at(i));
+        w_window.push_back(w_values.at(i));
+      }
+    }
+    REQUIRE(fitter.size() == x_window.size());
+
+    double const offset{left - 3.0};
+    types::OpenUniform<double> reference{
+        {offset, 20.0 + offset, num_knots}, {ctrl_pts}, degree
+    };
+    if (weighted)
+    {
+      reference.fit(x_window, y_window, w_window);
+    }
+    else
+    {
+      reference.fit(x_window, y_window);
+    }
+
+    REQUIRE_THAT(bspline.get_knots().domain().first, WithinAbs(left, 1e-12));
+    REQUIRE_THAT(bspline.get_knots().domain().second, WithinAbs(right, 1e-12));
+    for (size_t i{0}; i < ctrl_pts.size(); i++)
+    {
+      REQUIRE_THAT(
+          bspline.get_control_points().at(i),
+          WithinAbs(reference.get_control_points().at(i), 1e-8)
+      );
+    }
+  };
+
+  SECTION("fitter.add(x, y) slides the knots with the data")
+  {
+    WindowFitter fitter{bspline};
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      fitter.add(x_values.at(i), y_values.at(i));
+      if (i > 300 && i % 97 == 0)
+      {
+        fitter.finalize();
+        require_reference(fitter, i, INFINITY, false);
+      }
+    }
+    auto const [left, right] = fitter.domain();
+    REQUIRE(left <= x_values.back() - 13.0);
+    REQUIRE(x_values.back() < right);
+  }
+
+  SECTION("fitter.add(x, y, w) forgets samples older than the span")
+  {
+    double const span{13.4};
+    WindowFitter fitter{bspline, span};
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      fitter.add(x_values.at(i), y_values.at(i), w_values.at(i));
+      if (i > 300 && i % 89 == 0)
+      {
+        fitter.finalize();
+        require_reference(fitter, i, span, true);
+      }
+    }
+  }
+
+  SECTION("fitter.add(std::vector<T>, std::vector<T>) and fitter.reset()")
+  {
+    WindowFitter fitter{bspline, 13.9};
+    fitter.add(x_values, y_values);
+    fitter.finalize();
+    require_reference(fitter, x_values.size() - 1, 13.9, false);
+
+    fitter.reset();
+    REQUIRE(fitter.size() == 0);
+    REQUIRE_THROWS_AS(fitter.finalize(), std::runtime_error);
+
+    // Far past the window, every knot interval is replaced
+    std::vector<double> x_later{};
+    std::vector<double> y_later{};
+    for (double x{200.01}; x < 230.0; x += 0.1)
+    {
+      x_later.push_back(x);
+      y_later.push_back(std::cos(x));
+    }
+    fitter.add(x_later, y_later);
+    fitter.finalize();
+    REQUIRE(bspline.get_knots().domain().first > 200.0 - 14.0);
+    REQUIRE_THAT(bspline.evaluate(225.0), WithinAbs(std::cos(225.0), 1e-2));
+  }
+
+  SECTION("Empty knot intervals and invalid samples")
+  {
+    WindowFitter fitter{bspline};
+    fitter.add(5.0, 1.0);
+    REQUIRE_THROWS_AS(fitter.finalize(), std::runtime_error);
+    REQUIRE_THROWS_AS(fitter.add(4.0, 1.0), std::runtime_error);
+    REQUIRE_THROWS_AS(fitter.add(6.0, 1.0, -1.0), std::runtime_error);
+    REQUIRE_THROWS_AS(fitter.add(NAN, 1.0), std::runtime_error);
+
+    // Too many knot intervals ahead to count the slides, the fitter is left as it was
+    REQUIRE_THROWS_AS(fitter.add(1e25, 1.0), std::runtime_error);
+    REQUIRE(fitter.size() == 1);
+    fitter.add(1e12 + 0.5, 1.0);
+    REQUIRE(fitter.size() == 1);
+    REQUIRE(fitter.domain().first <= 1e12 + 0.5);
+    REQUIRE(1e12 + 0.5 < fitter.domain().second);
+
+    WindowFitter late{bspline};
+    REQUIRE_THROWS_AS(late.add(2.0, 1.0), std::runtime_error);
+    REQUIRE_THROWS_AS(
+        (WindowFitter<double, Curve::UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE>{
+            bspline, 13.0
+        }),
+        std::runtime_error
+    );
+  }
+}
@@ -0,0 +1,124 @@
+// Standard includes
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_types.hpp"
+#include "BSplineX/bspline/design_matrix.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::bspline;
+
+// Dense reference built from the sparse basis, wrapping periodic columns by hand
+template <typename BSplineType>
+Eigen::MatrixXd
+reference_matrix(BSplineType const &bspline, std::vector<double> const &x, size_t num_cols)
+{
+  size_t const degree{bspline.get_degree()};
+
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(x.size(), num_cols);
+  std::vector<double> nnz(degree + 1);
+  for (size_t i{0}; i < x.size(); i++)
+  {
+    size_t index = bspline.basis(x.at(i), nnz.begin());
+    for (size_t j{0}; j <= degree; j++)
+    {
+      A(i, (index + j) % num_cols) += nnz.at(j);
+    }
+  }
+  return A;
+}
+
+template <typename BSplineType>
+void check_design_matrix(
+    BSplineType const &bspline, std::vector<double> const &x, size_t num_cols
+)
+{
+  Eigen::MatrixXd expected = reference_matrix(bspline, x, num_cols);
+  size_t const stride{bspline.get_degree() + 1};
+
+  for (size_t num_threads : {1, 4})
+  {
+    auto csr = bspline.design_matrix(x, num_threads);
+    REQUIRE(csr.rows() == x.size());
+    REQUIRE(csr.cols() == num_cols);
+    REQUIRE(csr.nnz() == x.size() * stride);
+    REQUIRE(csr.map().isCompressed());
+
+    // Exactly `degree + 1` entries per row, columns strictly increasing
+    for (size_t i{0}; i < csr.rows(); i++)
+    {
+      REQUIRE(csr.outer_index()[i] == (int)(i * stride));
+      for (size_t k{i * stride + 1}; k < (i + 1) * stride; k++)
+      {
+        REQUIRE(csr.inner_index()[k - 1] < csr.inner_index()[k]);
+      }
+    }
+    Eigen::MatrixXd dense = csr.map().toDense();
+    REQUIRE(dense.isApprox(expected));
+
+    auto csc = bspline.template design_matrix<Eigen::ColMajor>(x, num_threads);
+    REQUIRE(csc.nnz() == csr.nnz());
+    REQUIRE(csc.outer_size() == csr.cols());
+    for (size_t j{0}; j < csc.outer_size(); j++)
+    {
+      for (int k{csc.outer_index()[j] + 1}; k < csc.outer_index()[j + 1]; k++)
+      {
+        REQUIRE(csc.inner_index()[k - 1] < csc.inner_index()[k]);
+      }
+    }
+    dense = csc.map().toDense();
+    REQUIRE(dense.isApprox(expected));
+
+    // Usable as is by Eigen's sparse algebra
+    Eigen::VectorXd ones = Eigen::VectorXd::Ones(csr.cols());
+    Eigen::VectorXd product = csr.map() * ones;
+    REQUIRE(product.isApprox(expected * ones));
+  }
+}
+
+TEST_CASE("bspline::BSpline<T, C, BC, EXT>::design_matrix(x, num_threads)", "[bspline]")
+{
+  std::vector<double> t_data_vec{0.1, 1.3, 2.2, 2.2, 4.9, 6.3, 6.3, 6.3, 13.2};
+  std::vector<double> c_data_vec{0.1, 1.3, 2.2, 3.2, 4.3, 5.6, 0.3, 13.2};
+  std::vector<double> clamped_c_data_vec{0.1, 1.3, 2.2, 3.2, 4.3, 5.6, 0.3, 13.2, 1.0, 2.0, 3.0};
+
+  // Enough points to span several parallel chunks
+  std::vector<double> x_values(3 * PARALLEL_CHUNK_SIZE + 17);
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = 0.1 + 13.0 * (double)i / (double)x_values.size();
+  }
+
+  SECTION("clamped")
+  {
+    types::ClampedNonUniform<double> bspline{{t_data_vec}, {clamped_c_data_vec}, 3};
+    check_design_matrix(bspline, x_values, clamped_c_data_vec.size());
+  }
+
+  SECTION("periodic, wrapped columns stay sorted")
+  {
+    types::PeriodicNonUniform<double> bspline{{t_data_vec}, {c_data_vec}, 3};
+    check_design_matrix(bspline, x_values, c_data_vec.size());
+  }
+
+  SECTION("periodic uniform")
+  {
+    types::PeriodicUniform<double> bspline{{0.0, 8.0, (size_t)9}, {c_data_vec}, 5};
+    check_design_matrix(bspline, x_values, c_data_vec.size());
+  }
+
+  SECTION("empty x")
+  {
+    types::ClampedNonUniform<double> bspline{{t_data_vec}, {clamped_c_data_vec}, 3};
+    auto csr = bspline.design_matrix(std::vector<double>{});
+    REQUIRE(csr.rows() == 0);
+    REQUIRE(csr.nnz() == 0);
+    auto csc = bspline.design_matrix<Eigen::ColMajor>(std::vector<double>{});
+    REQUIRE(csc.nnz() == 0);
+  }
+}
@@ -27,4 +27,11 @@ TEST_CASE("control_points::Atter<T, BC> atter{control_points::Data<T> data, degr
     REQUIRE(atter.at(data.size() + 1) == 1.3);
     REQUIRE(atter.at(data.size() + 2) == 2.2);
   }
+  SECTION("atter.data()")
+  {
+    for (size_t i{0}; i < atter.size(); i++)
+    {
+      REQUIRE(atter.data()[i] == atter.at(i));
+    }
+  }
 }
@@ -0,0 +1,106 @@
+// Standard includes
+#include <type_traits>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/control_points/control_points.hpp"
+#include "BSplineX/deboor/deboor.hpp"
+#include "BSplineX/knots/knots.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::deboor;
+
+template <size_t P>
+void check_against_dynamic()
+{
+  std::vector<double> t_data_vec{0.1, 1.3, 2.2, 2.2, 4.9, 6.3, 6.3, 6.3, 13.2};
+  std::vector<double> c_data_vec(t_data_vec.size() + P - 1);
+  for (size_t i{0}; i < c_data_vec.size(); i++)
+  {
+    c_data_vec.at(i) = 0.3 * (double)i * (double)i - 1.1 * (double)i + 0.7;
+  }
+
+  knots::Knots<double, Curve::NON_UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::NONE> knots{
+      {t_data_vec}, P
+  };
+  control_points::ControlPoints<double, BoundaryCondition::CLAMPED> control_points{
+      {c_data_vec}, P
+  };
+
+  DeBoor<double, P> fixed{};
+  DeBoor<double> dynamic{P};
+  REQUIRE(fixed.get_degree() == dynamic.get_degree());
+
+  std::vector<size_t> indices{};
+  std::vector<double> values{};
+  for (double x{0.1}; x < 13.2; x += 0.05)
+  {
+    auto [index, value] = knots.find(x);
+    indices.push_back(index);
+    values.push_back(value);
+
+    REQUIRE_THAT(
+        fixed.evaluate(knots.data(), control_points, index, value),
+        WithinRel(dynamic.evaluate(knots.data(), control_points, index, value))
+    );
+
+    std::vector<double> fixed_basis(P + 1, 0.0);
+    std::vector<double> dynamic_basis(P + 1, 0.0);
+    fixed.basis(knots.data(), index, value, fixed_basis.end());
+    dynamic.basis(knots.data(), index, value, dynamic_basis.end());
+    for (size_t j{0}; j <= P; j++)
+    {
+      REQUIRE_THAT(fixed_basis.at(j), WithinRel(dynamic_basis.at(j)));
+    }
+
+    std::vector<double> coeffs((P + 1) * (P + 1));
+    std::vector<double> polynomial_basis(P + 1, 0.0);
+    basis_polynomials(std::integral_constant<size_t, P>{}, knots.data(), index, coeffs.data());
+    double left{knots.data()[index]};
+    double u{(value - left) / (knots.data()[index + 1] - left)};
+    basis_at(std::integral_constant<size_t, P>{}, coeffs.data(), u, polynomial_basis.end());
+    for (size_t j{0}; j <= P; j++)
+    {
+      REQUIRE_THAT(polynomial_basis.at(j), WithinAbs(dynamic_basis.at(j), 1e-13));
+    }
+  }
+
+  size_t count = std::min(indices.size(), EVALUATE_BATCH_SIZE);
+  std::vector<double> fixed_results(count);
+  std::vector<double> dynamic_results(count);
+  fixed.evaluate(
+      knots.data(), control_points, indices.data(), values.data(), count, fixed_results.data()
+  );
+  dynamic.evaluate(
+      knots.data(), control_points, indices.data(), values.data(), count, dynamic_results.data()
+  );
+  for (size_t i{0}; i < count; i++)
+  {
+    REQUIRE_THAT(fixed_results.at(i), WithinRel(dynamic_results.at(i)));
+    REQUIRE_THAT(
+        fixed_results.at(i),
+        WithinRel(dynamic.evaluate(knots.data(), control_points, indices.at(i), values.at(i)))
+    );
+  }
+}
+
+TEST_CASE("deboor::DeBoor<T, P> matches deboor::DeBoor<T>", "[deboor]")
+{
+  SECTION("degree 1") { check_against_dynamic<1>(); }
+  SECTION("degree 2") { check_against_dynamic<2>(); }
+  SECTION("degree 3") { check_against_dynamic<3>(); }
+  SECTION("degree 5") { check_against_dynamic<5>(); }
+}
+
+TEST_CASE("deboor::dispatch(degree, kernel)", "[deboor]")
+{
+  for (size_t degree{0}; degree < 8; degree++)
+  {
+    REQUIRE(dispatch<double>(degree, [](auto &kernel) { return kernel.get_degree(); }) == degree);
+  }
+}
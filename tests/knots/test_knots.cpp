@@ -1,3 +1,7 @@
+// Standard includes
+#include <utility>
+#include <vector>
+
 // Third-party includes
 #include <catch2/catch_test_macros.hpp>
 #include <catch2/matchers/catch_matchers_floating_point.hpp>
@@ -42,4 +46,41 @@ TEST_CASE("knots::Knots<T, C, BC, EXT> knots{knots::Data<T, C> data, degree}", "
     REQUIRE(knots.find(13.2).first == 3);
     REQUIRE(knots.find(14.0).first == 3);
   }
+  SECTION("knots.find_ordered()")
+  {
+    size_t hint{degree};
+    for (double x{-20.0}; x < 30.0; x += 0.05)
+    {
+      auto [index, value] = knots.find_ordered(x, hint);
+      REQUIRE(index == knots.find(x).first);
+      REQUIRE(value == knots.find(x).second);
+      hint = index;
+    }
+  }
+  SECTION("copies and moves keep the search policy")
+  {
+    using PeriodicKnots =
+        Knots<double, Curve::NON_UNIFORM, BoundaryCondition::PERIODIC, Extrapolation::PERIODIC>;
+    for (Search search : {Search::EYTZINGER, Search::BUCKET})
+    {
+      // The originals are gone before the searches run
+      PeriodicKnots assigned{};
+      PeriodicKnots moved{};
+      {
+        PeriodicKnots original{data, degree, search};
+        PeriodicKnots copied{original};
+        moved    = std::move(copied);
+        assigned = original;
+      }
+      PeriodicKnots constructed{std::move(moved)};
+      for (PeriodicKnots const *other : {&assigned, &constructed})
+      {
+        REQUIRE(other->get_search() == search);
+        for (double x{-20.0}; x < 30.0; x += 0.05)
+        {
+          REQUIRE(other->find(x) == knots.find(x));
+        }
+      }
+    }
+  }
 }
@@ -30,6 +30,14 @@ TEST_CASE("knots::Atter<T, C, BC> atter{knots::Data<T, C> data, degree}", "[t_at
     REQUIRE_THAT(atter.at(data.size() + degree + 1), WithinRel(15.3));
     REQUIRE_THAT(atter.at(data.size() + degree + 2), WithinRel(18.0));
   }
+  SECTION("atter.data()")
+  {
+    double const *padded = atter.data();
+    for (size_t i{0}; i < atter.size(); i++)
+    {
+      REQUIRE(padded[i] == atter.at(i));
+    }
+  }
   SECTION("atter.begin()")
   {
     auto it = atter.begin();
@@ -1,4 +1,6 @@
 // Standard includes
+#include <algorithm>
+#include <vector>
 
 // Third-party includes
 #include <catch2/catch_test_macros.hpp>
@@ -32,4 +34,136 @@ TEST_CASE(
     REQUIRE(finder.find(2.2) == 6);
     REQUIRE(finder.find(6.3) == 10);
   }
+
+  SECTION("finder.find_ordered()")
+  {
+    for (size_t hint{0}; hint < atter.size(); hint++)
+    {
+      for (double x{0.1}; x <= 13.2; x += 0.1)
+      {
+        REQUIRE(finder.find_ordered(x, hint) == finder.find(x));
+      }
+      REQUIRE(finder.find_ordered(13.2, hint) == finder.find(13.2));
+    }
+  }
+}
+
+TEST_CASE(
+    "knots::Finder<double, UNIFORM, CLAMPED, CONSTANT> "
+    "finder{atter}",
+    "[t_finder]"
+)
+{
+  Data<double, Curve::UNIFORM> data{0.0, 10.0, (size_t)11};
+  size_t degree{2};
+  Atter<double, Curve::UNIFORM, BoundaryCondition::CLAMPED> atter{data, degree};
+  Finder<double, Curve::UNIFORM, BoundaryCondition::CLAMPED, Extrapolation::CONSTANT> finder{
+      atter, degree
+  };
+
+  SECTION("finder.find()")
+  {
+    REQUIRE(finder.find(0.0) == 2);
+    REQUIRE(finder.find(0.5) == 2);
+    REQUIRE(finder.find(1.0) == 3);
+    REQUIRE(finder.find(9.5) == 11);
+    REQUIRE(finder.find(10.0) == 11);
+  }
+}
+
+TEST_CASE(
+    "knots::Finder<double, NON_UNIFORM, OPEN, NONE> "
+    "finder{atter, degree, search}",
+    "[t_finder]"
+)
+{
+  // Irregular, with a few repeated knots
+  std::vector<double> data_vec{0.0};
+  for (size_t i{1}; i < 300; i++)
+  {
+    data_vec.push_back(data_vec.back() + (i % 5 == 0 ? 0.0 : 0.1 * (double)(1 + i % 3)));
+  }
+  Data<double, Curve::NON_UNIFORM> data{data_vec};
+  size_t degree{3};
+  Atter<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN> atter{data, degree};
+
+  Finder<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> reference{
+      atter, degree, Search::BINARY
+  };
+  REQUIRE(reference.get_search() == Search::BINARY);
+
+  for (Search search :
+       {Search::BRANCHLESS, Search::EYTZINGER, Search::LINEAR, Search::BUCKET, Search::AUTO})
+  {
+    Finder<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> finder{
+        atter, degree, search
+    };
+    REQUIRE(finder.get_search() != Search::AUTO);
+    for (double x{atter.at(degree)}; x <= atter.at(atter.size() - degree - 1); x += 0.05)
+    {
+      REQUIRE(finder.find(x) == reference.find(x));
+    }
+    for (size_t i{degree}; i < atter.size() - degree; i++)
+    {
+      REQUIRE(finder.find(atter.at(i)) == reference.find(atter.at(i)));
+    }
+  }
+}
+
+TEST_CASE(
+    "knots::Finder<double, NON_UNIFORM, OPEN, NONE> "
+    "finder{atter, degree, Search::BUCKET, num_buckets}",
+    "[t_finder]"
+)
+{
+  // Clustered knots, most buckets are empty and a few hold many knots
+  std::vector<double> data_vec{};
+  for (size_t i{0}; i < 200; i++)
+  {
+    double x{(double)i / 199.0};
+    data_vec.push_back(x * x * x * 10.0);
+  }
+  Data<double, Curve::NON_UNIFORM> data{data_vec};
+  size_t degree{3};
+  Atter<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN> atter{data, degree};
+
+  Finder<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> reference{
+      atter, degree, Search::BINARY
+  };
+  REQUIRE(reference.search_memory() == 0);
+
+  size_t last_memory{0};
+  for (size_t num_buckets : {1, 7, 199, 1000})
+  {
+    Finder<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> finder{
+        atter, degree, Search::BUCKET, num_buckets
+    };
+    REQUIRE(finder.get_num_buckets() == num_buckets);
+    REQUIRE(finder.search_memory() > last_memory);
+    last_memory = finder.search_memory();
+
+    double left{atter.at(degree)};
+    double right{atter.at(atter.size() - degree - 1)};
+    for (size_t i{0}; i <= 10000; i++)
+    {
+      double x{std::min(left + (right - left) * (double)i / 10000.0, right)};
+      REQUIRE(finder.find(x) == reference.find(x));
+    }
+    for (size_t i{degree}; i < atter.size() - degree; i++)
+    {
+      REQUIRE(finder.find(atter.at(i)) == reference.find(atter.at(i)));
+    }
+  }
+
+  Finder<double, Curve::NON_UNIFORM, BoundaryCondition::OPEN, Extrapolation::NONE> defaulted{
+      atter, degree, Search::BUCKET
+  };
+  REQUIRE(defaulted.get_num_buckets() == 193);
+}
+
+TEST_CASE("knots::choose_search(size)", "[t_finder]")
+{
+  REQUIRE(choose_search(8) == Search::LINEAR);
+  REQUIRE(choose_search(LINEAR_SEARCH_MAX + 1) == Search::BRANCHLESS);
+  REQUIRE(choose_search(EYTZINGER_SEARCH_MIN) == Search::EYTZINGER);
 }
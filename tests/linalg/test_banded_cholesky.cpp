@@ -0,0 +1,205 @@
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Dense>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/linalg/banded_cholesky.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::linalg;
+
+TEST_CASE("linalg::BandedCholesky<T> gram{num_cols, width}", "[linalg]")
+{
+  size_t num_rows{500};
+  size_t num_cols{60};
+  size_t width{4};
+
+  // Random rows with `width` consecutive non-zeros covering every column
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.1, 1.0};
+  std::vector<size_t> firsts(num_rows);
+  std::vector<double> coeffs(num_rows * width);
+  Eigen::MatrixXd A = Eigen::MatrixXd::Zero(num_rows, num_cols);
+  for (size_t i{0}; i < num_rows; i++)
+  {
+    firsts.at(i) = (i * (num_cols - width + 1)) / num_rows;
+    for (size_t j{0}; j < width; j++)
+    {
+      coeffs.at(i * width + j) = unif(rng);
+      A(i, firsts.at(i) + j)   = coeffs.at(i * width + j);
+    }
+  }
+
+  SECTION("gram.add_outer(first, coeffs, weight)")
+  {
+    BandedCholesky<double> gram{num_cols, width};
+    Eigen::VectorXd weights{num_rows};
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      weights(i) = (double)(i % 3) + 0.5;
+      gram.add_outer(firsts.at(i), coeffs.data() + i * width, weights(i));
+    }
+
+    Eigen::MatrixXd expected = A.transpose() * weights.asDiagonal() * A;
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      for (size_t j{i}; j < std::min(i + width, num_cols); j++)
+      {
+        REQUIRE_THAT(gram.at(i, j), WithinAbs(expected(i, j), 1e-12));
+      }
+    }
+  }
+
+  SECTION("gram.add_block(first, block)")
+  {
+    BandedCholesky<double> rows{num_cols, width};
+    BandedCholesky<double> blocks{num_cols, width};
+    std::vector<double> block(width * width, 0.0);
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      rows.add_outer(firsts.at(i), coeffs.data() + i * width);
+      for (size_t k{0}; k < width; k++)
+      {
+        for (size_t l{0}; l < width; l++)
+        {
+          block.at(k * width + l) += coeffs.at(i * width + k) * coeffs.at(i * width + l);
+        }
+      }
+      if (i + 1 == num_rows || firsts.at(i + 1) != firsts.at(i))
+      {
+        blocks.add_block(firsts.at(i), block.data());
+        std::fill(block.begin(), block.end(), 0.0);
+      }
+    }
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      for (size_t j{i}; j < std::min(i + width, num_cols); j++)
+      {
+        REQUIRE_THAT(blocks.at(i, j), WithinAbs(rows.at(i, j), 1e-12));
+      }
+    }
+  }
+
+  SECTION("gram.add(other)")
+  {
+    BandedCholesky<double> all{num_cols, width};
+    BandedCholesky<double> first_half{num_cols, width};
+    BandedCholesky<double> second_half{num_cols, width};
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      all.add_outer(firsts.at(i), coeffs.data() + i * width);
+      (i < num_rows / 2 ? first_half : second_half)
+          .add_outer(firsts.at(i), coeffs.data() + i * width);
+    }
+    first_half.add(second_half);
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      for (size_t j{i}; j < std::min(i + width, num_cols); j++)
+      {
+        REQUIRE_THAT(first_half.at(i, j), WithinAbs(all.at(i, j), 1e-12));
+      }
+    }
+  }
+
+  SECTION("gram.factorize() and gram.solve(b, num_rhs)")
+  {
+    BandedCholesky<double> gram{num_cols, width};
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      gram.add_outer(firsts.at(i), coeffs.data() + i * width);
+    }
+    REQUIRE(gram.factorize());
+    REQUIRE(gram.is_factorized());
+
+    size_t num_rhs{3};
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> b{num_cols, num_rhs};
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        b(k, q) = unif(rng);
+      }
+    }
+    Eigen::MatrixXd expected = (A.transpose() * A).llt().solve(Eigen::MatrixXd{b});
+
+    gram.solve(b.data(), num_rhs);
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        REQUIRE_THAT(b(k, q), WithinAbs(expected(k, q), 1e-9));
+      }
+    }
+  }
+
+  SECTION("gram.add(other, scale) and gram.quadratic_form(x)")
+  {
+    // A tridiagonal `other` added to the wider gram
+    BandedCholesky<double> gram{num_cols, width};
+    BandedCholesky<double> other{num_cols, 2};
+    Eigen::MatrixXd expected = A.transpose() * A;
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      gram.add_outer(firsts.at(i), coeffs.data() + i * width);
+    }
+    for (size_t k{0}; k + 1 < num_cols; k++)
+    {
+      double row[2]{1.0, -1.0};
+      other.add_outer(k, row);
+      expected(k, k) += 0.5;
+      expected(k + 1, k + 1) += 0.5;
+      expected(k, k + 1) -= 0.5;
+      expected(k + 1, k) -= 0.5;
+    }
+    gram.add(other, 0.5);
+
+    Eigen::VectorXd x{num_cols};
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      x(k) = unif(rng) - 0.5;
+    }
+    REQUIRE_THAT(gram.quadratic_form(x.data()), WithinRel(x.dot(expected * x), 1e-12));
+  }
+
+  SECTION("gram.log_determinant() and gram.selected_inverse()")
+  {
+    BandedCholesky<double> gram{num_cols, width};
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      gram.add_outer(firsts.at(i), coeffs.data() + i * width);
+    }
+    REQUIRE(gram.factorize());
+
+    Eigen::MatrixXd dense = A.transpose() * A;
+    REQUIRE_THAT(gram.log_determinant(), WithinRel(std::log(dense.determinant()), 1e-10));
+
+    Eigen::MatrixXd inverse     = dense.inverse();
+    std::vector<double> entries = gram.selected_inverse();
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      for (size_t j{i}; j < std::min(i + width, num_cols); j++)
+      {
+        REQUIRE_THAT(entries.at(i * width + j - i), WithinAbs(inverse(i, j), 1e-9));
+      }
+    }
+  }
+
+  SECTION("singular matrices are reported")
+  {
+    // Nothing touches the last columns
+    BandedCholesky<double> gram{num_cols, width};
+    for (size_t i{0}; i < num_rows / 2; i++)
+    {
+      gram.add_outer(firsts.at(i), coeffs.data() + i * width);
+    }
+    REQUIRE_FALSE(gram.factorize());
+  }
+}
@@ -0,0 +1,89 @@
+// Standard includes
+#include <random>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Dense>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/linalg/banded_lu.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::linalg;
+
+TEST_CASE("linalg::BandedLU<T> lu{num_cols, lower, upper, border}", "[linalg]")
+{
+  size_t num_cols{50};
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{-1.0, 1.0};
+
+  // Random entries wherever the structure allows them, with zeros on the diagonal every third row
+  // so that the factorization has to pivot
+  auto check = [&](size_t lower, size_t upper, size_t border)
+  {
+    BandedLU<double> lu{num_cols, lower, upper, border};
+    Eigen::MatrixXd dense = Eigen::MatrixXd::Zero(num_cols, num_cols);
+    size_t const lead{num_cols - border};
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      for (size_t j{0}; j < num_cols; j++)
+      {
+        bool in_band{j + lower >= i && j <= i + upper};
+        if ((i < lead && j < lead && !in_band) || (i == j && i % 3 == 1 && i < lead))
+        {
+          continue;
+        }
+        dense(i, j) = unif(rng);
+        lu.at(i, j) = dense(i, j);
+      }
+    }
+    REQUIRE(lu.factorize());
+    REQUIRE(lu.is_factorized());
+
+    size_t num_rhs{2};
+    Eigen::Matrix<double, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor> b{num_cols, num_rhs};
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        b(k, q) = unif(rng);
+      }
+    }
+    Eigen::MatrixXd expected = dense.fullPivLu().solve(Eigen::MatrixXd{b});
+
+    lu.solve(b.data(), num_rhs);
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        REQUIRE_THAT(b(k, q), WithinAbs(expected(k, q), 1e-8));
+      }
+    }
+  };
+
+  SECTION("banded") { check(2, 3, 0); }
+  SECTION("banded with a dense border") { check(3, 3, 4); }
+  SECTION("dense border only") { check(0, 0, num_cols); }
+
+  SECTION("singular matrices are reported")
+  {
+    // Two equal rows
+    BandedLU<double> lu{num_cols, 1, 1};
+    for (size_t i{0}; i < num_cols; i++)
+    {
+      lu.at(i, i) = 2.0;
+      if (i + 1 < num_cols)
+      {
+        lu.at(i, i + 1) = 1.0;
+        lu.at(i + 1, i) = 1.0;
+      }
+    }
+    lu.at(1, 0) = 2.0;
+    lu.at(1, 1) = 1.0;
+    lu.at(1, 2) = 0.0;
+    REQUIRE_FALSE(lu.factorize());
+  }
+}
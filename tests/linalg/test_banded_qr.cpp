@@ -0,0 +1,152 @@
+// Standard includes
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <random>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Dense>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/linalg/banded_qr.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::linalg;
+
+TEST_CASE("linalg::BandedQR<T> qr{num_cols, width}", "[linalg]")
+{
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.1, 1.0};
+
+  size_t num_cols{30};
+  size_t width{4};
+  size_t num_rows{10 * num_cols};
+
+  // Rows with `width` consecutive non-zeros, spread over every column
+  std::vector<size_t> firsts(num_rows);
+  std::vector<double> coeffs(num_rows * width);
+  std::vector<double> y(num_rows);
+  std::vector<double> w(num_rows);
+  for (size_t i{0}; i < num_rows; i++)
+  {
+    firsts.at(i) = (i * (num_cols - width + 1)) / num_rows;
+    for (size_t j{0}; j < width; j++)
+    {
+      coeffs.at(i * width + j) = unif(rng);
+    }
+    y.at(i) = unif(rng);
+    w.at(i) = unif(rng);
+  }
+
+  // Dense weighted least squares of the rows in `keep`
+  auto check = [&](BandedQR<double> const &qr, std::vector<bool> const &keep)
+  {
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(num_rows, num_cols);
+    Eigen::VectorXd b = Eigen::VectorXd::Zero(num_rows);
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      if (!keep.at(i))
+      {
+        continue;
+      }
+      double const scale{std::sqrt(w.at(i))};
+      for (size_t j{0}; j < width; j++)
+      {
+        A(i, firsts.at(i) + j) = scale * coeffs.at(i * width + j);
+      }
+      b(i) = scale * y.at(i);
+    }
+    Eigen::VectorXd expected = A.colPivHouseholderQr().solve(b);
+    Eigen::VectorXd residual = A * expected - b;
+
+    std::vector<double> x(num_cols);
+    REQUIRE(qr.solve(x.data()));
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      REQUIRE_THAT(x.at(k), WithinAbs(expected(k), 1e-9));
+    }
+    REQUIRE_THAT(qr.residual_sum(), WithinAbs(residual.squaredNorm(), 1e-9));
+  };
+
+  std::vector<bool> keep(num_rows, true);
+  BandedQR<double> qr{num_cols, width};
+  for (size_t i{0}; i < num_rows; i++)
+  {
+    qr.add_row(firsts.at(i), coeffs.data() + i * width, y.at(i), w.at(i));
+  }
+
+  SECTION("qr.add_row(first, coeffs, y, w)") { check(qr, keep); }
+
+  SECTION("qr.add_row(...) in any order")
+  {
+    std::vector<size_t> order(num_rows);
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), rng);
+    BandedQR<double> shuffled{num_cols, width};
+    for (size_t i : order)
+    {
+      shuffled.add_row(firsts.at(i), coeffs.data() + i * width, y.at(i), w.at(i));
+    }
+    check(shuffled, keep);
+  }
+
+  SECTION("qr.remove_row(first, coeffs, y, w)")
+  {
+    for (size_t i{0}; i < num_rows; i += 3)
+    {
+      REQUIRE(qr.remove_row(firsts.at(i), coeffs.data() + i * width, y.at(i), w.at(i)));
+      keep.at(i) = false;
+    }
+    check(qr, keep);
+  }
+
+  SECTION("qr.remove_row(...) refuses to empty a column")
+  {
+    // Column 0 only appears in the first row
+    BandedQR<double> single{num_cols, width};
+    single.add_row(0, coeffs.data(), y.at(0));
+    for (size_t i{1}; i < num_rows; i++)
+    {
+      single.add_row(std::max(firsts.at(i), (size_t)1), coeffs.data() + i * width, y.at(i));
+    }
+    std::vector<double> before(num_cols);
+    REQUIRE(single.solve(before.data()));
+
+    REQUIRE_FALSE(single.remove_row(0, coeffs.data(), y.at(0)));
+    std::vector<double> after(num_cols);
+    REQUIRE(single.solve(after.data()));
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      REQUIRE(after.at(k) == before.at(k));
+    }
+  }
+
+  SECTION("qr.merge(other, offset)")
+  {
+    // One factorization per block of `width` columns, then merged in order
+    size_t const num_blocks{num_cols - width + 1};
+    std::vector<BandedQR<double>> blocks(num_blocks, BandedQR<double>{width, width});
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      blocks.at(firsts.at(i)).add_row(0, coeffs.data() + i * width, y.at(i), w.at(i));
+    }
+    BandedQR<double> merged{num_cols, width};
+    for (size_t k{0}; k < num_blocks; k++)
+    {
+      merged.merge(blocks.at(k), k);
+    }
+    check(merged, keep);
+  }
+
+  SECTION("qr.reset()")
+  {
+    qr.reset();
+    std::vector<double> x(num_cols);
+    REQUIRE_FALSE(qr.solve(x.data()));
+    REQUIRE(qr.residual_sum() == 0.0);
+  }
+}
@@ -0,0 +1,87 @@
+// Standard includes
+#include <random>
+#include <vector>
+
+// Third-party includes
+#include <Eigen/Dense>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/linalg/banded_cholesky.hpp"
+#include "BSplineX/linalg/cyclic_banded_cholesky.hpp"
+#include "BSplineX/linalg/normal_equations.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::linalg;
+
+TEST_CASE("linalg::CyclicBandedCholesky<T> gram{num_cols, width}", "[linalg]")
+{
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{0.1, 1.0};
+
+  // Random rows with `width` consecutive non-zeros over `num_cols + width - 1` padded columns, the
+  // last `width - 1` of which alias the first ones
+  auto check = [&](size_t num_cols, size_t width)
+  {
+    size_t num_rows{10 * num_cols};
+    size_t num_rhs{2};
+    NormalEquations<double> padded{num_cols + width - 1, width, num_rhs};
+    Eigen::MatrixXd A = Eigen::MatrixXd::Zero(num_rows, num_cols);
+    Eigen::MatrixXd b{num_rows, num_rhs};
+    std::vector<double> coeffs(width);
+    for (size_t i{0}; i < num_rows; i++)
+    {
+      size_t const first{(i * num_cols) / num_rows};
+      for (size_t j{0}; j < width; j++)
+      {
+        coeffs.at(j) = unif(rng);
+        A(i, (first + j) % num_cols) += coeffs.at(j);
+      }
+      b(i, 0) = unif(rng);
+      b(i, 1) = unif(rng);
+      double const y[2]{b(i, 0), b(i, 1)};
+      padded.add_row(first, coeffs.data(), y);
+    }
+
+    Eigen::MatrixXd gram = A.transpose() * A;
+    Eigen::MatrixXd expected = gram.llt().solve(A.transpose() * b);
+
+    CyclicBandedCholesky<double> factor{num_cols, width};
+    factor.fold(padded.get_gram());
+    REQUIRE(factor.factorize());
+    REQUIRE(factor.is_factorized());
+
+    std::vector<double> x(num_cols * num_rhs);
+    REQUIRE(padded.solve_periodic(x.data(), num_cols));
+    for (size_t k{0}; k < num_cols; k++)
+    {
+      for (size_t q{0}; q < num_rhs; q++)
+      {
+        REQUIRE_THAT(x.at(k * num_rhs + q), WithinAbs(expected(k, q), 1e-9));
+      }
+    }
+  };
+
+  SECTION("gram.fold(padded) and solve") { check(40, 4); }
+  SECTION("tridiagonal") { check(25, 2); }
+  SECTION("fewer columns than the band") { check(3, 4); }
+  SECTION("diagonal") { check(10, 1); }
+
+  SECTION("singular matrices are reported")
+  {
+    // The last columns are never touched
+    size_t num_cols{20};
+    size_t width{3};
+    BandedCholesky<double> padded{num_cols + width - 1, width};
+    std::vector<double> coeffs{1.0, 2.0, 0.0};
+    for (size_t first{0}; first + 3 < num_cols; first++)
+    {
+      padded.add_outer(first, coeffs.data());
+    }
+    CyclicBandedCholesky<double> factor{num_cols, width};
+    factor.fold(padded);
+    REQUIRE_FALSE(factor.factorize());
+  }
+}
@@ -0,0 +1,60 @@
+// Standard includes
+#include <cmath>
+#include <complex>
+#include <random>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/linalg/fft.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::linalg;
+
+TEST_CASE("linalg::FFT<T> fft{size}", "[linalg]")
+{
+  std::mt19937 rng{42};
+  std::uniform_real_distribution<double> unif{-1.0, 1.0};
+  double const pi{std::acos(-1.0)};
+
+  // Powers of two, Bluestein sizes and a prime
+  for (size_t size : {1, 2, 8, 64, 3, 6, 100, 97})
+  {
+    std::vector<std::complex<double>> values(size);
+    for (auto &value : values)
+    {
+      value = {unif(rng), unif(rng)};
+    }
+
+    std::vector<std::complex<double>> expected(size);
+    for (size_t j{0}; j < size; j++)
+    {
+      for (size_t k{0}; k < size; k++)
+      {
+        double const angle{-2.0 * pi * (double)((j * k) % size) / (double)size};
+        expected.at(j) += values.at(k) * std::polar(1.0, angle);
+      }
+    }
+
+    FFT<double> fft{size};
+    REQUIRE(fft.size() == size);
+    std::vector<std::complex<double>> transformed{values};
+    fft.forward(transformed.data());
+    for (size_t j{0}; j < size; j++)
+    {
+      REQUIRE_THAT(transformed.at(j).real(), WithinAbs(expected.at(j).real(), 1e-10));
+      REQUIRE_THAT(transformed.at(j).imag(), WithinAbs(expected.at(j).imag(), 1e-10));
+    }
+
+    fft.inverse(transformed.data());
+    for (size_t k{0}; k < size; k++)
+    {
+      REQUIRE_THAT(transformed.at(k).real(), WithinAbs(values.at(k).real(), 1e-12));
+      REQUIRE_THAT(transformed.at(k).imag(), WithinAbs(values.at(k).imag(), 1e-12));
+    }
+  }
+}
@@ -0,0 +1,74 @@
+// Standard includes
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+
+// BSplineX includes
+#include "BSplineX/parallel/parallel.hpp"
+
+using namespace bsplinex;
+using namespace bsplinex::parallel;
+
+TEST_CASE("parallel::for_each_chunk(num_items, chunk_size, num_threads, f)", "[parallel]")
+{
+  REQUIRE(default_threads() >= 1);
+
+  SECTION("every item is visited exactly once")
+  {
+    for (size_t num_threads : {0, 1, 2, 3, 8})
+    {
+      for (size_t num_items : {0, 1, 99, 100, 101, 1000})
+      {
+        // Catch2 assertions are not thread-safe, check the chunks after joining
+        std::vector<std::atomic<int>> visits(num_items);
+        std::atomic<bool> bad_chunk{false};
+        for_each_chunk(
+            num_items,
+            10,
+            num_threads,
+            [&](size_t first, size_t last)
+            {
+              if (first >= last || last - first > 10)
+              {
+                bad_chunk = true;
+              }
+              for (size_t i{first}; i < last; i++)
+              {
+                visits[i]++;
+              }
+            }
+        );
+        REQUIRE_FALSE(bad_chunk);
+        for (auto const &visit : visits)
+        {
+          REQUIRE(visit == 1);
+        }
+      }
+    }
+  }
+
+  SECTION("exceptions are forwarded to the caller")
+  {
+    for (size_t num_threads : {1, 4})
+    {
+      REQUIRE_THROWS_AS(
+          for_each_chunk(
+              1000,
+              10,
+              num_threads,
+              [](size_t first, size_t)
+              {
+                if (first == 500)
+                {
+                  throw std::runtime_error("chunk failed");
+                }
+              }
+          ),
+          std::runtime_error
+      );
+    }
+  }
+}
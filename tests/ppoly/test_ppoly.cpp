@@ -0,0 +1,88 @@
+// Standard includes
+#include <stdexcept>
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline_types.hpp"
+#include "BSplineX/ppoly/ppoly.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::ppoly;
+
+template <typename T, Curve C, BoundaryCondition BC, Extrapolation EXT>
+void check_against_bspline(bspline::BSpline<T, C, BC, EXT> const &bspline, T first, T last)
+{
+  PPoly<T, C, BC, EXT> ppoly{bspline};
+  REQUIRE(ppoly.get_degree() == bspline.get_degree());
+
+  std::vector<T> x_values{};
+  for (T x{first}; x < last; x += 0.01)
+  {
+    x_values.push_back(x);
+  }
+
+  std::vector<T> results = ppoly.evaluate(x_values);
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    T expected = bspline.evaluate(x_values.at(i));
+    REQUIRE_THAT(ppoly.evaluate(x_values.at(i)), WithinRel(expected, 1e-9) || WithinAbs(expected, 1e-12));
+    REQUIRE_THAT(results.at(i), WithinRel(expected, 1e-9) || WithinAbs(expected, 1e-12));
+  }
+}
+
+TEST_CASE("ppoly::PPoly<T, C, BC, EXT> ppoly{bspline}", "[ppoly]")
+{
+  std::vector<double> t_data_vec{0.1, 1.3, 2.2, 2.2, 4.9, 6.3, 6.3, 6.3, 13.2};
+
+  SECTION("BoundaryCondition::OPEN, Extrapolation::NONE")
+  {
+    types::OpenNonUniform<double> bspline{{t_data_vec}, {{0.1, 1.3, 2.2, 4.9, 13.2}}, 3};
+    check_against_bspline(bspline, 2.2, 6.3);
+
+    PPoly ppoly{bspline};
+    REQUIRE(ppoly.num_intervals() == 2);
+    REQUIRE_THROWS_AS(ppoly.evaluate(1.0), std::runtime_error);
+  }
+
+  SECTION("BoundaryCondition::CLAMPED, Extrapolation::CONSTANT")
+  {
+    std::vector<double> c_data_vec{0.1, 1.3, 2.2, 2.5, 3.2, 4.3, 4.9, 5.6, 5.4, 0.3, 13.2};
+    for (size_t degree : {1, 2, 3, 5})
+    {
+      c_data_vec.resize(t_data_vec.size() + degree - 1, 1.0);
+      types::ClampedNonUniformConstant<double> bspline{{t_data_vec}, {c_data_vec}, degree};
+      check_against_bspline(bspline, -1.0, 14.0);
+    }
+  }
+
+  SECTION("BoundaryCondition::PERIODIC, Extrapolation::PERIODIC")
+  {
+    types::PeriodicNonUniform<double> bspline{
+        {t_data_vec}, {{0.1, 1.3, 2.2, 3.2, 4.3, 5.6, 0.3, 13.2}}, 3
+    };
+    check_against_bspline(bspline, -20.0, 30.0);
+  }
+
+  SECTION("Curve::UNIFORM")
+  {
+    types::ClampedUniformConstant<double> bspline{
+        {0.0, 10.0, (size_t)11}, {{0.1, 1.3, 2.2, 2.5, 3.2, 4.3, 4.9, 5.6, 5.4, 0.3, 13.2, 1.0}}, 2
+    };
+    check_against_bspline(bspline, -1.0, 11.0);
+  }
+
+  SECTION("ppoly.get_coefficients(...)")
+  {
+    // A linear spline is the linear interpolant of its control points
+    types::ClampedNonUniform<double> bspline{{{0.0, 1.0, 3.0}}, {{2.0, 4.0, 0.0}}, 1};
+    PPoly ppoly{bspline};
+    REQUIRE(ppoly.num_intervals() == 2);
+    REQUIRE(ppoly.get_coefficients(1) == std::vector<double>{2.0, 2.0});
+    REQUIRE(ppoly.get_coefficients(2) == std::vector<double>{4.0, -2.0});
+  }
+}
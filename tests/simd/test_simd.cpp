@@ -0,0 +1,101 @@
+// Standard includes
+#include <vector>
+
+// Third-party includes
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+
+// BSplineX includes
+#include "BSplineX/bspline/bspline.hpp"
+#include "BSplineX/simd/simd.hpp"
+
+using namespace Catch::Matchers;
+using namespace bsplinex;
+using namespace bsplinex::simd;
+
+template <typename T, Curve C>
+knots::Data<T, C> make_knots_data()
+{
+  if constexpr (C == Curve::UNIFORM)
+  {
+    return {(T)0.5, (T)13.5, (size_t)40};
+  }
+  else
+  {
+    std::vector<T> t_data_vec{};
+    for (size_t i{0}; i < 40; i++)
+    {
+      t_data_vec.push_back((T)i * (T)0.3 + (T)(i % 3) * (T)0.1 + (T)0.5);
+    }
+    return {t_data_vec};
+  }
+}
+
+// Every kernel the CPU supports against the scalar `evaluate`, with a batch size that leaves
+// remainders for every vector width and a few values to extrapolate
+template <typename T, Curve C>
+void check_against_scalar(size_t degree, T tolerance)
+{
+  knots::Data<T, C> t_data = make_knots_data<T, C>();
+
+  bspline::BSpline<T, C, BoundaryCondition::CLAMPED, Extrapolation::CONSTANT> bspline{};
+  {
+    knots::Knots<T, C, BoundaryCondition::CLAMPED, Extrapolation::CONSTANT> knots{t_data, degree};
+    std::vector<T> c_data_vec(knots.size() - degree - 1);
+    for (size_t i{0}; i < c_data_vec.size(); i++)
+    {
+      c_data_vec.at(i) = (T)(0.3 * (double)i - 0.02 * (double)(i * i) + 1.1 * (double)(i % 4));
+    }
+    bspline = {t_data, {c_data_vec}, degree};
+  }
+
+  auto [left, right] = bspline.get_knots().domain();
+  std::vector<T> x_values(301);
+  for (size_t i{0}; i < x_values.size(); i++)
+  {
+    x_values.at(i) = left + (right - left) * (T)i / (T)(x_values.size() - 11);
+  }
+  x_values.at(100) = left - (T)1;
+
+  for (Isa isa : {Isa::SCALAR, Isa::SSE, Isa::AVX2, Isa::AVX512})
+  {
+    bspline.set_isa(isa);
+    REQUIRE(static_cast<int>(bspline.get_isa()) <= static_cast<int>(isa));
+
+    std::vector<T> results = bspline.evaluate(x_values);
+    std::vector<T> ordered = bspline.evaluate_ordered(x_values);
+    for (size_t i{0}; i < x_values.size(); i++)
+    {
+      T expected = bspline.evaluate(x_values.at(i));
+      REQUIRE_THAT(results.at(i), WithinAbs(expected, tolerance));
+      REQUIRE_THAT(ordered.at(i), WithinAbs(expected, tolerance));
+    }
+
+    // All values inside the domain, uniform curves locate them with the vector kernel too
+    std::vector<T> inside{x_values.begin(), x_values.begin() + 100};
+    results = bspline.evaluate(inside);
+    for (size_t i{0}; i < inside.size(); i++)
+    {
+      REQUIRE_THAT(results.at(i), WithinAbs(bspline.evaluate(inside.at(i)), tolerance));
+    }
+  }
+}
+
+TEST_CASE("simd::resolve_isa(isa)", "[simd]")
+{
+  Isa best = detect_isa();
+  REQUIRE(resolve_isa(Isa::AUTO) == best);
+  REQUIRE(resolve_isa(Isa::SCALAR) == Isa::SCALAR);
+  REQUIRE(static_cast<int>(resolve_isa(Isa::AVX512)) <= static_cast<int>(best));
+}
+
+TEST_CASE("simd kernels match the scalar bspline::BSpline::evaluate", "[simd]")
+{
+  for (size_t degree : {1, 2, 3, 4, 5, 7})
+  {
+    check_against_scalar<double, Curve::UNIFORM>(degree, 1e-12);
+    check_against_scalar<double, Curve::NON_UNIFORM>(degree, 1e-12);
+    check_against_scalar<float, Curve::UNIFORM>(degree, 1e-4f);
+    check_against_scalar<float, Curve::NON_UNIFORM>(degree, 1e-4f);
+  }
+}